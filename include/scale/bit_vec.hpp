@@ -0,0 +1,336 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_BIT_VEC_HPP
+#define SCALE_CORE_SCALE_BIT_VEC_HPP
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <limits>
+#include <vector>
+
+#include <gsl/span>
+
+#include <scale/outcome/outcome_throw.hpp>
+#include <scale/scale_error.hpp>
+#include <scale/types.hpp>
+
+namespace scale {
+
+  /**
+   * Order of bits in encoded bytes: Lsb0 puts the first bit of each byte to
+   * its least significant bit, Msb0 to its most significant one
+   */
+  enum class BitOrder {
+    LSB0,
+    MSB0,
+  };
+
+  /**
+   * @class BasicBitVec sequence of bits packed into 64-bit words, encoded as
+   * compact number of bits followed by bits packed into bytes
+   * @tparam Order order of bits in encoded bytes
+   */
+  template <BitOrder Order>
+  class BasicBitVec {
+   public:
+    using Word = uint64_t;
+    static constexpr size_t kWordBits = 64;
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    BasicBitVec() = default;
+
+    explicit BasicBitVec(size_t size, bool value = false) {
+      resize(size, value);
+    }
+
+    BasicBitVec(std::initializer_list<bool> bits) {
+      words_.reserve(wordsFor(bits.size()));
+      for (auto bit : bits) {
+        push_back(bit);
+      }
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    bool operator[](size_t i) const {
+      return ((words_[i / kWordBits] >> (i % kWordBits)) & 1u) != 0;
+    }
+
+    void set(size_t i, bool value = true) {
+      auto mask = Word{1} << (i % kWordBits);
+      if (value) {
+        words_[i / kWordBits] |= mask;
+      } else {
+        words_[i / kWordBits] &= ~mask;
+      }
+    }
+
+    void push_back(bool value) {
+      if (size_ % kWordBits == 0) {
+        words_.push_back(0);
+      }
+      set(size_++, value);
+    }
+
+    void resize(size_t size, bool value = false) {
+      auto old_size = size_;
+      words_.resize(wordsFor(size), value ? ~Word{0} : 0);
+      size_ = size;
+      if (size > old_size and old_size % kWordBits != 0) {
+        // fill the rest of the last old word
+        auto &word = words_[old_size / kWordBits];
+        auto tail = ~Word{0} << (old_size % kWordBits);
+        word = value ? word | tail : word & ~tail;
+      }
+      clearTail();
+    }
+
+    void clear() {
+      words_.clear();
+      size_ = 0;
+    }
+
+    /**
+     * @return number of set bits
+     */
+    size_t count() const {
+      size_t count = 0;
+      for (auto word : words_) {
+        count += popcount(word);
+      }
+      return count;
+    }
+
+    bool any() const {
+      return findFirst() != npos;
+    }
+
+    bool none() const {
+      return not any();
+    }
+
+    /**
+     * @return index of the first set bit or npos
+     */
+    size_t findFirst() const {
+      return findFrom(0);
+    }
+
+    /**
+     * @return index of the first set bit after pos or npos
+     */
+    size_t findNext(size_t pos) const {
+      return pos + 1 >= size_ ? npos : findFrom(pos + 1);
+    }
+
+    /**
+     * Bitwise operations keep size of this vector, missing bits of the other
+     * one are zeros
+     */
+    BasicBitVec &operator&=(const BasicBitVec &other) {
+      for (size_t i = 0; i < words_.size(); ++i) {
+        words_[i] &= i < other.words_.size() ? other.words_[i] : 0;
+      }
+      return *this;
+    }
+
+    BasicBitVec &operator|=(const BasicBitVec &other) {
+      auto n = std::min(words_.size(), other.words_.size());
+      for (size_t i = 0; i < n; ++i) {
+        words_[i] |= other.words_[i];
+      }
+      clearTail();
+      return *this;
+    }
+
+    BasicBitVec &operator^=(const BasicBitVec &other) {
+      auto n = std::min(words_.size(), other.words_.size());
+      for (size_t i = 0; i < n; ++i) {
+        words_[i] ^= other.words_[i];
+      }
+      clearTail();
+      return *this;
+    }
+
+    friend BasicBitVec operator&(BasicBitVec lhs, const BasicBitVec &rhs) {
+      return lhs &= rhs;
+    }
+
+    friend BasicBitVec operator|(BasicBitVec lhs, const BasicBitVec &rhs) {
+      return lhs |= rhs;
+    }
+
+    friend BasicBitVec operator^(BasicBitVec lhs, const BasicBitVec &rhs) {
+      return lhs ^= rhs;
+    }
+
+    bool operator==(const BasicBitVec &other) const {
+      return size_ == other.size_ and words_ == other.words_;
+    }
+
+    bool operator!=(const BasicBitVec &other) const {
+      return not(*this == other);
+    }
+
+    /**
+     * @return bits packed into words, the first bit is the least significant
+     * bit of the first word, unused bits of the last word are zeros
+     */
+    gsl::span<const Word> words() const {
+      return words_;
+    }
+
+    /**
+     * @brief replaces content with bits packed into bytes in Order
+     * @param bytes at least (size + 7) / 8 bytes
+     * @param size number of bits
+     */
+    void assignBytes(gsl::span<const uint8_t> bytes, size_t size) {
+      words_.assign(wordsFor(size), 0);
+      size_ = size;
+      auto n = std::min<size_t>(bytes.size(), (size + 7) / 8);
+      for (size_t i = 0; i < n; ++i) {
+        words_[i / 8] |= Word{bytes[i]} << (8 * (i % 8));
+      }
+      for (auto &word : words_) {
+        word = toOrder(word);
+      }
+      clearTail();
+    }
+
+    /**
+     * @brief packs bits into bytes in Order
+     * @param out receives (size + 7) / 8 bytes
+     */
+    void packBytes(uint8_t *out) const {
+      auto remaining = (size_ + 7) / 8;
+      for (auto word : words_) {
+        word = toOrder(word);
+        auto n = std::min(remaining, sizeof(Word));
+        for (size_t i = 0; i < n; ++i) {
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+          out[i] = static_cast<uint8_t>(word >> (8 * i));
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out += n;
+        remaining -= n;
+      }
+    }
+
+   private:
+    static size_t wordsFor(size_t bits) {
+      return (bits + kWordBits - 1) / kWordBits;
+    }
+
+    static size_t popcount(Word word) {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_popcountll(word);
+#else
+      size_t count = 0;
+      for (; word != 0; word &= word - 1) {
+        ++count;
+      }
+      return count;
+#endif
+    }
+
+    static size_t countTrailingZeros(Word word) {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll(word);
+#else
+      size_t count = 0;
+      for (; (word & 1u) == 0; word >>= 1u) {
+        ++count;
+      }
+      return count;
+#endif
+    }
+
+    // converts between Lsb0 word and bytes in Order, the conversion is its
+    // own inverse
+    static Word toOrder(Word word) {
+      if constexpr (Order == BitOrder::MSB0) {
+        // reverse bits of each byte
+        word = ((word >> 1u) & 0x5555555555555555ull)
+               | ((word & 0x5555555555555555ull) << 1u);
+        word = ((word >> 2u) & 0x3333333333333333ull)
+               | ((word & 0x3333333333333333ull) << 2u);
+        word = ((word >> 4u) & 0x0f0f0f0f0f0f0f0full)
+               | ((word & 0x0f0f0f0f0f0f0f0full) << 4u);
+      }
+      return word;
+    }
+
+    size_t findFrom(size_t pos) const {
+      auto i = pos / kWordBits;
+      if (i >= words_.size()) {
+        return npos;
+      }
+      auto word = words_[i] & (~Word{0} << (pos % kWordBits));
+      while (word == 0) {
+        if (++i == words_.size()) {
+          return npos;
+        }
+        word = words_[i];
+      }
+      return i * kWordBits + countTrailingZeros(word);
+    }
+
+    // bits beyond the size are kept zero for word operations
+    void clearTail() {
+      if (size_ % kWordBits != 0) {
+        words_.back() &= ~(~Word{0} << (size_ % kWordBits));
+      }
+    }
+
+    std::vector<Word> words_;
+    size_t size_ = 0;
+  };
+
+  using BitVec = BasicBitVec<BitOrder::LSB0>;
+  using BitVecMsb0 = BasicBitVec<BitOrder::MSB0>;
+
+  /**
+   * @brief encodes bit vector as compact number of bits and packed bits,
+   * which are written into the stream at once
+   */
+  template <class Stream,
+            BitOrder Order,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const BasicBitVec<Order> &v) {
+    s << CompactInteger{v.size()};
+    return s.putGenerated(
+        (v.size() + 7) / 8, 0, [&v](uint8_t *out) { v.packBytes(out); });
+  }
+
+  /**
+   * @brief decodes bit vector, unused bits of the last byte are ignored
+   */
+  template <class Stream,
+            BitOrder Order,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, BasicBitVec<Order> &v) {
+    CompactInteger bits;
+    s >> bits;
+    // number of bytes must be addressable
+    if (bits > std::numeric_limits<uint32_t>::max() * CompactInteger{8}) {
+      raise(DecodeError::TOO_MANY_ITEMS);
+    }
+    auto size = bits.convert_to<size_t>();
+    v.assignBytes(s.nextBytes((size + 7) / 8), size);
+    return s;
+  }
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_BIT_VEC_HPP
@@ -0,0 +1,264 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_COLUMNS_HPP
+#define SCALE_CORE_SCALE_COLUMNS_HPP
+
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include <boost/endian/conversion.hpp>
+#include <gsl/span>
+
+#include <scale/outcome/outcome_throw.hpp>
+#include <scale/scale_decoder_stream.hpp>
+#include <scale/scale_encoder_stream.hpp>
+#include <scale/skip.hpp>
+#include <scale/view.hpp>
+
+namespace scale {
+
+  namespace detail {
+    template <class Fields>
+    struct ColumnsOf;
+
+    template <class... Ts>
+    struct ColumnsOf<std::tuple<Ts...>> {
+      using type = std::tuple<std::vector<Ts>...>;
+    };
+
+    // encoded value is the value in memory, up to the byte order
+    template <class T>
+    constexpr bool kIsBulkCopyable =
+        (std::is_integral_v<T> and not std::is_same_v<T, bool>)
+        or std::is_same_v<T, std::array<uint8_t, sizeof(T)>>;
+
+    template <class T>
+    void storeField(uint8_t *out, const T &value) {
+      if constexpr (std::is_same_v<T, bool>) {
+        *out = value ? 1 : 0;
+      } else if constexpr (std::is_integral_v<T>) {
+        auto little = boost::endian::native_to_little(value);
+        std::memcpy(out, &little, sizeof(T));
+      } else {
+        std::memcpy(out, value.data(), sizeof(T));
+      }
+    }
+
+    template <class T, class Columns, size_t... I>
+    ScaleEncoderStream &encodeColumns(ScaleEncoderStream &s,
+                                      const Columns &columns,
+                                      std::index_sequence<I...> indices) {
+      using Fields = field_types_t<T>;
+      auto size = static_cast<size_t>(std::get<0>(columns).size());
+      if (((static_cast<size_t>(std::get<I>(columns).size()) != size)
+           or ...)) {
+        raise(EncodeError::COLUMN_SIZE_MISMATCH);
+      }
+      s << CompactInteger{size};
+      constexpr bool kBulk =
+          ((kIsBulkCopyable<std::tuple_element_t<I, Fields>>
+            or std::is_same_v<std::tuple_element_t<I, Fields>, bool>)
+           and ...);
+      if constexpr (kBulk) {
+        // elements of static size are interleaved into the space reserved
+        // for all of them
+        constexpr auto stride = *kStaticSize<T>;
+        constexpr auto offsets = staticFieldOffsets<Fields>(indices);
+        return s.putGenerated(size * stride, 0, [&](uint8_t *out) {
+          for (size_t row = 0; row < size; ++row) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            (storeField(out + offsets.offsets[I], std::get<I>(columns)[row]),
+             ...);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            out += stride;
+          }
+        });
+      } else {
+        for (size_t row = 0; row < size; ++row) {
+          ((s << std::get<I>(columns)[row]), ...);
+        }
+        return s;
+      }
+    }
+  }  // namespace detail
+
+  /**
+   * @brief scale-encodes columns of fields as Vec<T> of elements made of
+   * them, without building the elements. Elements of integers, bools and
+   * byte arrays are written at once into the space of exact size reserved
+   * for all of them, other elements field by field.
+   * @code{.cpp}
+   * encodeColumns<std::pair<AccountId, uint64_t>>(s, accounts, balances);
+   * @endcode
+   * @tparam T pair, tuple or struct described with SCALE_TIE
+   * @param s stream
+   * @param columns random access collections of the fields, in the order of
+   * the fields and of the same size
+   * @return reference to stream
+   */
+  template <class T, class... Cs>
+  ScaleEncoderStream &encodeColumns(ScaleEncoderStream &s,
+                                    const Cs &...columns) {
+    using Fields = field_types_t<T>;
+    static_assert(sizeof...(Cs) == std::tuple_size_v<Fields>
+                      and sizeof...(Cs) != 0,
+                  "a column is expected for each field");
+    static_assert(
+        std::is_same_v<Fields, std::tuple<std::remove_const_t<
+                                   typename Cs::value_type>...>>,
+        "columns must hold values of the fields");
+    return detail::encodeColumns<T>(s,
+                                    std::forward_as_tuple(columns...),
+                                    std::index_sequence_for<Cs...>{});
+  }
+
+  /**
+   * @class Columns vector of pairs, tuples or structs described with
+   * SCALE_TIE, encoded as Vec<T> and kept as a vector of each field, so that
+   * scans of a few fields read contiguous memory. Values of static size are
+   * decoded column by column from the encoded elements: integers and byte
+   * arrays with strided copies, other fields with a decoder each. Other
+   * values are decoded field by field into the columns. Columns are encoded
+   * back with encodeColumns.
+   * @code{.cpp}
+   * OUTCOME_TRY(events, scale::decode<Columns<Event>>(encoded));
+   * for (auto amount : events.column<2>()) { ... }
+   * @endcode
+   * @tparam T element type
+   */
+  template <class T>
+  class Columns {
+    using Fields = field_types_t<T>;
+
+   public:
+    static constexpr size_t kFields = std::tuple_size_v<Fields>;
+
+    template <size_t I>
+    using field_t = std::tuple_element_t<I, Fields>;
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    /**
+     * @tparam I index of the field
+     * @return values of the field of all the elements
+     */
+    template <size_t I>
+    const std::vector<field_t<I>> &column() const {
+      return std::get<I>(columns_);
+    }
+
+    bool operator==(const Columns &other) const {
+      return columns_ == other.columns_;
+    }
+    bool operator!=(const Columns &other) const {
+      return not(*this == other);
+    }
+
+    friend ScaleEncoderStream &operator<<(ScaleEncoderStream &s,
+                                          const Columns &v) {
+      return std::apply(
+          [&s](const auto &...columns) -> ScaleEncoderStream & {
+            return encodeColumns<T>(s, columns...);
+          },
+          v.columns_);
+    }
+
+    friend ScaleDecoderStream &operator>>(ScaleDecoderStream &s,
+                                          Columns &v) {
+      Columns columns;
+      columns.decode(s, std::make_index_sequence<kFields>{});
+      v = std::move(columns);
+      return s;
+    }
+
+   private:
+    template <size_t... I>
+    void decode(ScaleDecoderStream &s, std::index_sequence<I...> indices) {
+      size_ = detail::decodeLength(s);
+      if constexpr (kStaticSize<T>.has_value()) {
+        constexpr auto stride = *kStaticSize<T>;
+        if (stride != 0
+            and size_ > std::numeric_limits<uint32_t>::max() / stride) {
+          raise(DecodeError::NOT_ENOUGH_DATA);
+        }
+        auto encoded = s.nextBytes(size_ * stride);
+        (decodeColumn<I>(encoded), ...);
+      } else {
+        // each element has a field of dynamic size, which takes at least a
+        // byte
+        if (not s.hasMore(size_)) {
+          raise(DecodeError::NOT_ENOUGH_DATA);
+        }
+        (std::get<I>(columns_).resize(size_), ...);
+        for (size_t row = 0; row < size_; ++row) {
+          decodeRow(s, row, indices);
+        }
+      }
+    }
+
+    template <size_t I>
+    void decodeColumn(gsl::span<const uint8_t> encoded) {
+      using F = field_t<I>;
+      constexpr auto stride = *kStaticSize<T>;
+      constexpr auto offset = kOffsets.offsets[I];
+      constexpr auto size = *kStaticSize<F>;
+      auto &column = std::get<I>(columns_);
+      column.resize(size_);
+      if constexpr (detail::kIsBulkCopyable<F>) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const auto *field = encoded.data() + offset;
+        for (size_t row = 0; row < size_; ++row) {
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+          std::memcpy(&column[row], field + row * stride, size);
+        }
+        if constexpr (std::is_integral_v<F> and sizeof(F) > 1) {
+          for (auto &value : column) {
+            boost::endian::little_to_native_inplace(value);
+          }
+        }
+      } else {
+        for (size_t row = 0; row < size_; ++row) {
+          ScaleDecoderStream fs{encoded.subspan(row * stride + offset, size)};
+          decodeField(fs, column, row);
+        }
+      }
+    }
+
+    template <size_t... I>
+    void decodeRow(ScaleDecoderStream &s,
+                   size_t row,
+                   std::index_sequence<I...> /*unused*/) {
+      (decodeField(s, std::get<I>(columns_), row), ...);
+    }
+
+    // decoded through a temporary, as elements of vector<bool> are proxies
+    template <class F>
+    static void decodeField(ScaleDecoderStream &s,
+                            std::vector<F> &column,
+                            size_t row) {
+      F value{};
+      s >> value;
+      column[row] = std::move(value);
+    }
+
+    static constexpr auto kOffsets = detail::staticFieldOffsets<Fields>(
+        std::make_index_sequence<kFields>{});
+
+    typename detail::ColumnsOf<Fields>::type columns_;
+    size_t size_ = 0;
+  };
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_COLUMNS_HPP
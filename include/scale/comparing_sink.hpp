@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_COMPARING_SINK_HPP
+#define SCALE_CORE_SCALE_COMPARING_SINK_HPP
+
+#include <cstring>
+
+#include <scale/encoder_sink.hpp>
+#include <scale/outcome/outcome_throw.hpp>
+#include <scale/scale_encoder_stream.hpp>
+#include <scale/scale_error.hpp>
+
+namespace scale {
+
+  /**
+   * @class ComparingSink checks encoded data against expected bytes as it is
+   * produced. The first difference is thrown as
+   * EncodeError::UNEXPECTED_ENCODING, so that encoding stops there, and the
+   * following data is ignored.
+   */
+  class ComparingSink final : public EncoderSink {
+   public:
+    explicit ComparingSink(gsl::span<const uint8_t> expected)
+        : expected_{expected}, offset_{0}, mismatch_{false} {}
+
+    void write(gsl::span<const uint8_t> bytes) override {
+      if (mismatch_) {
+        return;
+      }
+      auto size = static_cast<size_t>(bytes.size());
+      if (size > static_cast<size_t>(expected_.size()) - offset_
+          or (size != 0
+              and std::memcmp(&expected_[offset_], bytes.data(), size) != 0)) {
+        mismatch_ = true;
+        raise(EncodeError::UNEXPECTED_ENCODING);
+      }
+      offset_ += size;
+    }
+
+    /**
+     * @return true if data differed from the expected bytes
+     */
+    bool mismatch() const {
+      return mismatch_;
+    }
+
+    /**
+     * @return true if all the expected bytes were matched
+     */
+    bool complete() const {
+      return not mismatch_ and offset_ == static_cast<size_t>(expected_.size());
+    }
+
+   private:
+    gsl::span<const uint8_t> expected_;
+    size_t offset_;
+    bool mismatch_;
+  };
+
+  /**
+   * @brief checks whether encoded value equals the given bytes without
+   * materializing the encoded value. The stream is not buffered, so the
+   * sink compares the data as it is encoded and nothing is allocated for
+   * values encoded without batches. Encoding stops at the first difference
+   * or once the encoded value gets longer than the given bytes.
+   * @tparam T value type
+   * @param value value to encode
+   * @param encoded bytes to compare with
+   * @return true if encoded value is exactly the given bytes, false otherwise
+   * including the case when the value cannot be encoded
+   */
+  template <class T>
+  bool equals_encoded(const T &value, gsl::span<const uint8_t> encoded) {
+    ComparingSink sink{encoded};
+    ScaleEncoderStream s{sink, 0};
+    s.setSizeLimit(encoded.size());
+    try {
+      s << value;
+    } catch (std::system_error &) {
+      return false;
+    }
+    return sink.complete();
+  }
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_COMPARING_SINK_HPP
@@ -0,0 +1,289 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_COMPRESSION_HPP
+#define SCALE_CORE_SCALE_COMPRESSION_HPP
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+#include <gsl/span>
+
+#include <scale/encoder_sink.hpp>
+#include <scale/outcome/outcome.hpp>
+#include <scale/scale.hpp>
+
+namespace scale {
+
+  /**
+   * @brief CompressionError enum provides error codes for compressed frames
+   */
+  enum class CompressionError {
+    UNKNOWN_CODEC = 1,   ///< no codec with the id of the frame
+    CORRUPTED_DATA,      ///< compressed body is malformed or truncated
+    SIZE_MISMATCH,       ///< body does not match the uncompressed size
+    TOO_LARGE,           ///< uncompressed size exceeds the allowed limit
+    COMPRESSION_FAILED,  ///< compressor failed to complete the body
+  };
+
+  /**
+   * @class Compressor compresses a stream of data
+   */
+  class Compressor {
+   public:
+    virtual ~Compressor() = default;
+
+    /**
+     * @brief compresses the next piece of data, failures are thrown as
+     * CompressionError::COMPRESSION_FAILED
+     * @param input uncompressed data
+     * @param finish whether it is the last piece, so the compressed stream is
+     * to be completed
+     * @param out receives compressed data
+     */
+    virtual void compress(gsl::span<const uint8_t> input,
+                          bool finish,
+                          EncoderSink &out) = 0;
+  };
+
+  /**
+   * @class Decompressor decompresses a stream of data into bounded output
+   */
+  class Decompressor {
+   public:
+    virtual ~Decompressor() = default;
+
+    /**
+     * @brief decompresses as much as fits into output, malformed input is
+     * thrown as CompressionError::CORRUPTED_DATA
+     * @param input compressed data, advanced past the consumed bytes
+     * @param output space for decompressed data, advanced past the produced
+     * bytes
+     * @return true when the end of the compressed stream is reached
+     */
+    virtual bool decompress(gsl::span<const uint8_t> &input,
+                            gsl::span<uint8_t> &output) = 0;
+  };
+
+  /**
+   * @class CompressionCodec compression backend, identified in frame headers
+   * by its id
+   */
+  class CompressionCodec {
+   public:
+    virtual ~CompressionCodec() = default;
+
+    virtual uint8_t id() const = 0;
+
+    virtual std::unique_ptr<Compressor> compressor() const = 0;
+
+    virtual std::unique_ptr<Decompressor> decompressor() const = 0;
+  };
+
+  /**
+   * @class ZlibCodec zlib format backed by the system zlib
+   */
+  class ZlibCodec final : public CompressionCodec {
+   public:
+    static constexpr uint8_t kId = 1;
+    static constexpr int kDefaultLevel = 6;
+
+    /**
+     * @param level compression level from 0 (none) to 9 (best)
+     */
+    explicit ZlibCodec(int level = kDefaultLevel) : level_{level} {}
+
+    uint8_t id() const override {
+      return kId;
+    }
+
+    std::unique_ptr<Compressor> compressor() const override;
+
+    std::unique_ptr<Decompressor> decompressor() const override;
+
+   private:
+    int level_;
+  };
+
+  /**
+   * @return codecs of this library with default settings, used for decoding
+   * unless others are given
+   */
+  gsl::span<const CompressionCodec *const> builtinCodecs();
+
+  /**
+   * Compressed frame is
+   *   codec id (u8) | compact uncompressed size | compressed body
+   * @class CompressingSink writes a frame, compressing data while it is
+   * being encoded. Errors are thrown as std::system_error.
+   * @code{.cpp}
+   * CompressingSink sink{file_sink, codec, encodedSize(proof).value()};
+   * ScaleEncoderStream s{sink};
+   * s << proof;
+   * s.flush();
+   * sink.finish();
+   * @endcode
+   */
+  class CompressingSink final : public EncoderSink {
+   public:
+    /**
+     * @brief writes the frame header to out
+     * @param out receives the frame
+     * @param codec compression backend
+     * @param size exact size of the data to be written
+     */
+    CompressingSink(EncoderSink &out,
+                    const CompressionCodec &codec,
+                    uint64_t size);
+
+    void write(gsl::span<const uint8_t> bytes) override;
+
+    /**
+     * @brief completes the compressed body, the sink must not be used after
+     */
+    void finish();
+
+   private:
+    EncoderSink &out_;
+    std::unique_ptr<Compressor> compressor_;
+    uint64_t remaining_;
+  };
+
+  /**
+   * @class DecompressingSource reads the data of a frame in bounded chunks
+   */
+  class DecompressingSource {
+   public:
+    /**
+     * @brief parses the frame header
+     * @param frame compressed frame, must outlive the source
+     * @param codecs codecs to look the frame's codec up among
+     * @return source or error
+     */
+    static outcome::result<DecompressingSource> open(
+        gsl::span<const uint8_t> frame,
+        gsl::span<const CompressionCodec *const> codecs = builtinCodecs());
+
+    /**
+     * @return uncompressed size declared in the frame header
+     */
+    uint64_t size() const {
+      return size_;
+    }
+
+    /**
+     * @brief decompresses the next chunk of data
+     * @param chunk space for the data
+     * @return filled part of the chunk, empty at the end of the data
+     */
+    outcome::result<gsl::span<uint8_t>> read(gsl::span<uint8_t> chunk);
+
+   private:
+    DecompressingSource(gsl::span<const uint8_t> body,
+                        std::unique_ptr<Decompressor> decompressor,
+                        uint64_t size);
+
+    gsl::span<const uint8_t> body_;
+    std::unique_ptr<Decompressor> decompressor_;
+    uint64_t size_;
+    uint64_t remaining_;
+    bool finished_;
+  };
+
+  /// size of chunks data is decompressed by before decoding
+  constexpr size_t kDecompressionChunkSize = 1u << 16u;
+
+  /// default limit of uncompressed size of decoded frames
+  constexpr uint64_t kMaxUncompressedSize = 1ull << 30u;
+
+  /**
+   * @return size of encoded values or error
+   */
+  template <typename... Args>
+  outcome::result<size_t> encodedSize(Args &&... args) {
+    ScaleEncoderStream s{true};
+    try {
+      (s << ... << std::forward<Args>(args));
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return s.size();
+  }
+
+  /**
+   * @brief writes data as a compressed frame
+   * @param out receives the frame
+   * @param codec compression backend
+   * @param data uncompressed data
+   */
+  outcome::result<void> compressFrame(EncoderSink &out,
+                                      const CompressionCodec &codec,
+                                      gsl::span<const uint8_t> data);
+
+  /**
+   * @brief encodes values once into a stream from the pool of the calling
+   * thread and compresses its storage into a frame
+   * @param out receives the frame
+   * @param codec compression backend
+   * @param args values to encode
+   */
+  template <typename... Args>
+  outcome::result<void> encodeCompressed(EncoderSink &out,
+                                         const CompressionCodec &codec,
+                                         Args &&... args) {
+    auto s = EncoderPool::acquire();
+    try {
+      (*s << ... << std::forward<Args>(args));
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    // the storage is given back to the pooled stream afterwards
+    ByteArray encoded;
+    s->swapBuffer(encoded);
+    auto res = compressFrame(out, codec, encoded);
+    s->swapBuffer(encoded);
+    return res;
+  }
+
+  /**
+   * @brief decompresses a frame chunk by chunk directly into the buffer of
+   * its declared size and decodes the value
+   * @param frame compressed frame
+   * @param max_size limit of the uncompressed size
+   * @param codecs codecs to look the frame's codec up among
+   * @return decoded value or error
+   */
+  template <class T>
+  outcome::result<T> decodeCompressed(
+      gsl::span<const uint8_t> frame,
+      uint64_t max_size = kMaxUncompressedSize,
+      gsl::span<const CompressionCodec *const> codecs = builtinCodecs()) {
+    OUTCOME_TRY(source, DecompressingSource::open(frame, codecs));
+    if (source.size() > max_size) {
+      return CompressionError::TOO_LARGE;
+    }
+    ByteArray data(source.size());
+    gsl::span<uint8_t> rest{data};
+    while (not rest.empty()) {
+      OUTCOME_TRY(chunk,
+                  source.read(rest.first(
+                      std::min<size_t>(rest.size(), kDecompressionChunkSize))));
+      rest = rest.subspan(chunk.size());
+    }
+    // makes sure the body ends where the declared size does
+    std::array<uint8_t, 1> extra{};
+    OUTCOME_TRY(tail, source.read(extra));
+    if (not tail.empty()) {
+      return CompressionError::SIZE_MISMATCH;
+    }
+    return decode<T>(data);
+  }
+
+}  // namespace scale
+
+OUTCOME_HPP_DECLARE_ERROR_2(scale, CompressionError)
+
+#endif  // SCALE_CORE_SCALE_COMPRESSION_HPP
@@ -0,0 +1,142 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_DETAIL_COMPACT_BATCH_HPP
+#define SCALE_CORE_SCALE_DETAIL_COMPACT_BATCH_HPP
+
+#include <limits>
+#include <optional>
+
+#include <gsl/span>
+
+#include <scale/scale_error.hpp>
+#include <scale/types.hpp>
+
+namespace scale::detail {
+
+  template <class T>
+  struct CompactValue {
+    using type = T;
+  };
+
+  template <class T>
+  struct CompactValue<Compact<T>> {
+    using type = T;
+  };
+
+  /// integer type of compact values decoded to Out
+  template <class Out>
+  using compact_value_t = typename CompactValue<Out>::type;
+
+  /**
+   * @brief decodes a single compact value with native integers
+   * @tparam T unsigned integer type
+   * @param bytes encoded data starting with the value
+   * @param value receives decoded value
+   * @return size of the encoded value or error
+   */
+  template <class T>
+  outcome::result<size_t> decodeCompactValue(gsl::span<const uint8_t> bytes,
+                                             T &value) {
+    if (bytes.empty()) {
+      return DecodeError::NOT_ENOUGH_DATA;
+    }
+    auto first = bytes[0];
+    // number of bytes holding the value in modes other than big integer
+    size_t size = 1u << (first & 0b11u);
+    if (size == 8) {
+      size = (first >> 2u) + 5;
+    }
+    if (static_cast<size_t>(bytes.size()) < size) {
+      return DecodeError::NOT_ENOUGH_DATA;
+    }
+    uint64_t number = 0;
+    if (size <= 4) {
+      for (size_t i = 0; i < size; ++i) {
+        number |= uint64_t{bytes[i]} << (8 * i);
+      }
+      number >>= 2u;
+    } else {
+      for (size_t i = 1; i < size; ++i) {
+        if (i > sizeof(uint64_t)) {
+          if (bytes[i] != 0) {
+            return DecodeError::VALUE_OUT_OF_RANGE;
+          }
+        } else {
+          number |= uint64_t{bytes[i]} << (8 * (i - 1));
+        }
+      }
+    }
+    if (number > std::numeric_limits<T>::max()) {
+      return DecodeError::VALUE_OUT_OF_RANGE;
+    }
+    value = static_cast<T>(number);
+    return size;
+  }
+
+  /**
+   * Result of batch decoding of compact values
+   */
+  struct CompactBatchResult {
+    // number of decoded values
+    size_t decoded;
+    // size of the decoded values
+    size_t consumed;
+    // error decoding the value following the decoded ones
+    std::optional<DecodeError> error;
+  };
+
+  /**
+   * @brief decodes consecutive compact values. Blocks of values of the same
+   * size, which are the usual case for indices and counters, are classified
+   * and decoded with SIMD instructions where available.
+   * @tparam Out uint32_t, uint64_t or Compact of them
+   * @param bytes encoded data
+   * @param out receives out.size() values
+   * @return numbers of decoded values and consumed bytes, and the error
+   * stopping decoding early
+   */
+  template <class Out>
+  CompactBatchResult decodeCompactBatch(gsl::span<const uint8_t> bytes,
+                                        gsl::span<Out> out);
+
+  /**
+   * @brief the same as decodeCompactBatch, without SIMD instructions
+   */
+  template <class Out>
+  CompactBatchResult decodeCompactBatchScalar(gsl::span<const uint8_t> bytes,
+                                              gsl::span<Out> out);
+
+  /**
+   * @brief computes size of compact encoding of values, with SIMD
+   * instructions where available
+   * @tparam In uint32_t, uint64_t or Compact of them
+   * @param values values to encode
+   * @return total size of encoded values
+   */
+  template <class In>
+  size_t compactBatchSize(gsl::span<const In> values);
+
+  /// bytes encodeCompactBatch may write past the end of encoded values
+  constexpr size_t kCompactBatchSlack = 8;
+
+  /**
+   * @brief compact-encodes values one after another
+   * @tparam In uint32_t, uint64_t or Compact of them
+   * @param values values to encode
+   * @param out buffer of compactBatchSize(values) + kCompactBatchSlack bytes
+   * @return size of encoded values
+   */
+  template <class In>
+  size_t encodeCompactBatch(gsl::span<const In> values, uint8_t *out);
+
+  template <class T>
+  constexpr bool kIsBatchCompact =
+      std::is_same_v<T, Compact<uint32_t>>
+      or std::is_same_v<T, Compact<uint64_t>>;
+
+}  // namespace scale::detail
+
+#endif  // SCALE_CORE_SCALE_DETAIL_COMPACT_BATCH_HPP
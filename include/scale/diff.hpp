@@ -0,0 +1,245 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_DIFF_HPP
+#define SCALE_CORE_SCALE_DIFF_HPP
+
+#include <cstring>
+#include <vector>
+
+#include <gsl/span>
+
+#include <scale/outcome/outcome.hpp>
+#include <scale/skip.hpp>
+#include <scale/tie.hpp>
+
+namespace scale {
+
+  /**
+   * @brief DiffError enum provides error codes for patching
+   */
+  enum class DiffError {
+    INVALID_PATCH = 1,  ///< splices overlap, are unordered or out of bounds
+  };
+
+  /**
+   * Replacement of a range of the old encoded value
+   */
+  struct Splice {
+    SCALE_TIE(3);
+    // offset in the old encoded value
+    uint64_t offset;
+    // number of old bytes replaced
+    uint64_t removed;
+    ByteArray inserted;
+
+    bool operator==(const Splice &other) const {
+      return as_tie() == other.as_tie();
+    }
+  };
+
+  /**
+   * Difference between two encoded values as splices ordered by offset,
+   * which is SCALE-encodable itself
+   */
+  using Patch = std::vector<Splice>;
+
+  namespace detail {
+    /**
+     * @class DiffBuilder collects replaced ranges into splices, merging
+     * adjacent ones
+     */
+    class DiffBuilder {
+     public:
+      DiffBuilder(gsl::span<const uint8_t> old_bytes,
+                  gsl::span<const uint8_t> new_bytes)
+          : old_{old_bytes}, new_{new_bytes} {}
+
+      /**
+       * @brief replaces [old_begin, old_end) of the old value with
+       * [new_begin, new_end) of the new value if they differ
+       */
+      void replace(size_t old_begin,
+                   size_t old_end,
+                   size_t new_begin,
+                   size_t new_end);
+
+      Patch finish() {
+        return std::move(patch_);
+      }
+
+     private:
+      gsl::span<const uint8_t> old_;
+      gsl::span<const uint8_t> new_;
+      Patch patch_;
+      // end of the last splice in the new value
+      size_t last_new_end_ = 0;
+    };
+
+    // offsets of elements of a collection and of its end
+    template <class E>
+    std::vector<size_t> elementBounds(ScaleDecoderStream &s, size_t count) {
+      std::vector<size_t> bounds;
+      if constexpr (kStaticSize<E>.has_value()) {
+        // elements of static size are not visited, their count is checked
+        // against the data by skipping them
+        auto begin = s.currentIndex();
+        skipElements<E>(s, count);
+        bounds.reserve(count + 1);
+        for (size_t i = 0; i <= count; ++i) {
+          bounds.push_back(begin + i * *kStaticSize<E>);
+        }
+      } else {
+        bounds.reserve(std::min<size_t>(count, s.span().size()) + 1);
+        bounds.push_back(s.currentIndex());
+        for (size_t i = 0; i < count; ++i) {
+          skip<E>(s);
+          bounds.push_back(s.currentIndex());
+        }
+      }
+      return bounds;
+    }
+
+    template <class T>
+    void diffValue(DiffBuilder &builder,
+                   ScaleDecoderStream &old_s,
+                   ScaleDecoderStream &new_s);
+
+    template <class E>
+    void diffElements(DiffBuilder &builder,
+                      ScaleDecoderStream &old_s,
+                      ScaleDecoderStream &new_s,
+                      size_t old_count,
+                      size_t new_count) {
+      auto old_bounds = elementBounds<E>(old_s, old_count);
+      auto new_bounds = elementBounds<E>(new_s, new_count);
+      auto old_bytes = old_s.span();
+      auto new_bytes = new_s.span();
+      auto equal = [&](size_t old_i, size_t new_i) {
+        auto size = old_bounds[old_i + 1] - old_bounds[old_i];
+        return size == new_bounds[new_i + 1] - new_bounds[new_i]
+               and std::memcmp(&old_bytes[old_bounds[old_i]],
+                               &new_bytes[new_bounds[new_i]],
+                               size)
+                       == 0;
+      };
+
+      // unchanged elements at the beginning and at the end
+      size_t prefix = 0;
+      while (prefix < old_count and prefix < new_count
+             and equal(prefix, prefix)) {
+        ++prefix;
+      }
+      size_t suffix = 0;
+      while (suffix < old_count - prefix and suffix < new_count - prefix
+             and equal(old_count - suffix - 1, new_count - suffix - 1)) {
+        ++suffix;
+      }
+
+      if (old_count == new_count) {
+        // changed elements in place
+        for (size_t i = prefix; i < old_count - suffix; ++i) {
+          builder.replace(old_bounds[i],
+                          old_bounds[i + 1],
+                          new_bounds[i],
+                          new_bounds[i + 1]);
+        }
+      } else {
+        // inserted or removed elements
+        builder.replace(old_bounds[prefix],
+                        old_bounds[old_count - suffix],
+                        new_bounds[prefix],
+                        new_bounds[new_count - suffix]);
+      }
+    }
+
+    template <class Tuple, size_t... I>
+    void diffFields(DiffBuilder &builder,
+                    ScaleDecoderStream &old_s,
+                    ScaleDecoderStream &new_s,
+                    std::index_sequence<I...> /*unused*/) {
+      (diffValue<std::tuple_element_t<I, Tuple>>(builder, old_s, new_s), ...);
+    }
+
+    template <class T>
+    void diffValue(DiffBuilder &builder,
+                   ScaleDecoderStream &old_s,
+                   ScaleDecoderStream &new_s) {
+      using V = std::decay_t<T>;
+      if constexpr (is_sequence<V>::value
+                    or ScaleDecoderStream::is_map_like<V>::value) {
+        auto old_begin = old_s.currentIndex();
+        auto new_begin = new_s.currentIndex();
+        auto old_count = decodeLength(old_s);
+        auto new_count = decodeLength(new_s);
+        builder.replace(
+            old_begin, old_s.currentIndex(), new_begin, new_s.currentIndex());
+        // elements of zero size never differ, while their count is not
+        // bounded by the data
+        if constexpr (kStaticSize<typename V::value_type> != 0) {
+          diffElements<typename V::value_type>(
+              builder, old_s, new_s, old_count, new_count);
+        }
+      } else if constexpr (has_fields<V>::value) {
+        using Fields = typename FieldTypes<V>::type;
+        diffFields<Fields>(
+            builder,
+            old_s,
+            new_s,
+            std::make_index_sequence<std::tuple_size_v<Fields>>{});
+      } else {
+        auto old_begin = old_s.currentIndex();
+        auto new_begin = new_s.currentIndex();
+        skip<V>(old_s);
+        skip<V>(new_s);
+        builder.replace(
+            old_begin, old_s.currentIndex(), new_begin, new_s.currentIndex());
+      }
+    }
+  }  // namespace detail
+
+  /**
+   * @brief computes difference between two encoded values of type T.
+   * Elements of collections and maps are compared individually, fields of
+   * tuples and structs described with SCALE_TIE are compared separately,
+   * other values are replaced as a whole.
+   * @tparam T type of the values
+   * @param old_encoded encoded old value
+   * @param new_encoded encoded new value
+   * @return patch transforming old value to the new one or DecodeError
+   */
+  template <class T>
+  outcome::result<Patch> diff(gsl::span<const uint8_t> old_encoded,
+                              gsl::span<const uint8_t> new_encoded) {
+    detail::DiffBuilder builder{old_encoded, new_encoded};
+    ScaleDecoderStream old_s{old_encoded};
+    ScaleDecoderStream new_s{new_encoded};
+    try {
+      detail::diffValue<T>(builder, old_s, new_s);
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    // trailing data is not a part of the value, but is kept in sync too
+    builder.replace(old_s.currentIndex(),
+                    old_encoded.size(),
+                    new_s.currentIndex(),
+                    new_encoded.size());
+    return builder.finish();
+  }
+
+  /**
+   * @brief applies the patch to the old encoded value
+   * @param old_encoded encoded value the patch was made for
+   * @param patch patch made by diff
+   * @return new encoded value or DiffError
+   */
+  outcome::result<ByteArray> patch(gsl::span<const uint8_t> old_encoded,
+                                   const Patch &patch);
+
+}  // namespace scale
+
+OUTCOME_HPP_DECLARE_ERROR_2(scale, DiffError)
+
+#endif  // SCALE_CORE_SCALE_DIFF_HPP
@@ -0,0 +1,284 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_DYNAMIC_DECODER_HPP
+#define SCALE_CORE_SCALE_DYNAMIC_DECODER_HPP
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/variant.hpp>
+#include <gsl/span>
+
+#include <scale/outcome/outcome.hpp>
+#include <scale/scale_decoder_stream.hpp>
+#include <scale/types.hpp>
+
+/**
+ * Decoding of types known only at runtime, e.g. from chain metadata.
+ * Types are described in a TypeRegistry, then each type of interest is
+ * compiled once into a DecodePlan, which is run over encoded data as many
+ * times as needed, either building a generic Value or driving a Visitor.
+ */
+namespace scale::dynamic {
+
+  /**
+   * @brief DynamicTypeError enum provides error codes for compilation of
+   * decode plans
+   */
+  enum class DynamicTypeError {
+    UNKNOWN_TYPE = 1,   ///< type id is not registered or not defined
+    NOT_AN_INTEGER,     ///< compact type wraps a non-integer type
+    INFINITE_TYPE,      ///< composite type contains itself directly
+    DUPLICATE_VARIANT,  ///< variant arms have the same index
+  };
+
+  using TypeId = uint32_t;
+
+  enum class Primitive : uint8_t {
+    BOOL,
+    U8,
+    U16,
+    U32,
+    U64,
+    U128,
+    I8,
+    I16,
+    I32,
+    I64,
+    I128,
+    STR,
+  };
+
+  /// struct of fields, names are informational
+  struct CompositeType {
+    std::vector<std::pair<std::string, TypeId>> fields;
+  };
+
+  /// enumeration of arms with fields, selected by an index byte
+  struct VariantType {
+    struct Arm {
+      uint8_t index;
+      std::string name;
+      std::vector<TypeId> fields;
+    };
+    std::vector<Arm> arms;
+  };
+
+  /// compact length prefixed collection
+  struct SequenceType {
+    TypeId element;
+  };
+
+  /// fixed-size collection
+  struct ArrayType {
+    TypeId element;
+    uint32_t length;
+  };
+
+  struct TupleType {
+    std::vector<TypeId> elements;
+  };
+
+  /// compact-encoded unsigned integer
+  struct CompactType {
+    TypeId integer;
+  };
+
+  using TypeDef = boost::variant<Primitive,
+                                 CompositeType,
+                                 VariantType,
+                                 SequenceType,
+                                 ArrayType,
+                                 TupleType,
+                                 CompactType>;
+
+  /**
+   * @class TypeRegistry runtime descriptions of types referring to each other
+   * by ids
+   */
+  class TypeRegistry {
+   public:
+    /**
+     * @brief registers a type
+     * @return id of the type
+     */
+    TypeId add(TypeDef def);
+
+    /**
+     * @brief registers id for a type to be defined later, so that recursive
+     * types can refer to themselves
+     * @return id of the type
+     */
+    TypeId reserve();
+
+    /**
+     * @brief defines a type previously reserved
+     */
+    void define(TypeId id, TypeDef def);
+
+    /**
+     * @return type definition or nullptr if the type is unknown
+     */
+    const TypeDef *find(TypeId id) const;
+
+   private:
+    std::vector<std::optional<TypeDef>> types_;
+  };
+
+  struct VariantValue;
+
+  /**
+   * Generic decoded value. Unsigned integers up to 64 bits are kept as
+   * uint64_t, signed ones as int64_t, 128-bit integers and compacts not fitting
+   * into uint64_t as CompactInteger. Sequences and arrays of u8 are kept as
+   * bytes, other collections, tuples and composites as vectors of values.
+   */
+  struct Value {
+    using Data = boost::variant<bool,
+                                uint64_t,
+                                int64_t,
+                                CompactInteger,
+                                std::string,
+                                ByteArray,
+                                std::vector<Value>,
+                                boost::recursive_wrapper<VariantValue>>;
+    Data data;
+
+    bool operator==(const Value &other) const {
+      return data == other.data;
+    }
+  };
+
+  struct VariantValue {
+    uint8_t index;
+    std::vector<Value> fields;
+
+    bool operator==(const VariantValue &other) const {
+      return index == other.index and fields == other.fields;
+    }
+  };
+
+  /**
+   * @class Visitor receives decoded values in order of their appearance,
+   * spans and views are valid only during the call
+   */
+  class Visitor {
+   public:
+    virtual ~Visitor() = default;
+
+    virtual void onBool(bool /*unused*/) {}
+    virtual void onUnsigned(uint64_t /*unused*/) {}
+    virtual void onSigned(int64_t /*unused*/) {}
+    virtual void onBigInteger(const CompactInteger & /*unused*/) {}
+    virtual void onString(std::string_view /*unused*/) {}
+    virtual void onBytes(gsl::span<const uint8_t> /*unused*/) {}
+
+    /// composite or tuple with the given number of fields
+    virtual void beginComposite(size_t /*unused*/) {}
+    virtual void endComposite() {}
+
+    /// sequence or array with the given number of elements
+    virtual void beginSequence(size_t /*unused*/) {}
+    virtual void endSequence() {}
+
+    /// variant arm with the given index
+    virtual void beginVariant(uint8_t /*unused*/) {}
+    virtual void endVariant() {}
+  };
+
+  /**
+   * @class DecodePlan flat sequence of decoding instructions compiled for a
+   * type, does not depend on the registry after compilation
+   */
+  class DecodePlan {
+   public:
+    // maximum nesting of sequences, arrays and variants in decoded data,
+    // which bounds the stack used by decoding untrusted data
+    static constexpr size_t kMaxNestingDepth = 256;
+
+    /**
+     * @brief compiles the plan
+     * @param registry types description
+     * @param type type to compile the plan for
+     * @return plan or DynamicTypeError
+     */
+    static outcome::result<DecodePlan> compile(const TypeRegistry &registry,
+                                               TypeId type);
+
+    /**
+     * @brief decodes a value from the stream, reporting it to the visitor
+     * @throws std::system_error with DecodeError on malformed data or data
+     * nested deeper than kMaxNestingDepth
+     */
+    void run(ScaleDecoderStream &stream, Visitor &visitor) const;
+
+    /**
+     * @brief decodes a value from the stream
+     * @throws std::system_error with DecodeError on malformed data
+     */
+    Value decode(ScaleDecoderStream &stream) const;
+
+    /**
+     * @brief decodes a value from bytes
+     * @return value or DecodeError
+     */
+    outcome::result<Value> decode(gsl::span<const uint8_t> bytes) const;
+
+   private:
+    friend class PlanCompiler;
+
+    enum class Op : uint8_t {
+      BOOL,
+      U8,
+      U16,
+      U32,
+      U64,
+      U128,
+      I8,
+      I16,
+      I32,
+      I64,
+      I128,
+      STR,
+      COMPACT,
+      BYTES_SEQUENCE,
+      BYTES_ARRAY,
+      BEGIN_COMPOSITE,
+      END_COMPOSITE,
+      SEQUENCE,
+      ARRAY,
+      VARIANT,
+    };
+
+    struct Instruction {
+      Op op;
+      // program of elements or table of variant arms
+      uint32_t target;
+      // number of elements or fields
+      uint32_t count;
+    };
+
+    // program of each arm by index, -1 if there is no arm with such index
+    using VariantTable = std::array<int32_t, 256>;
+
+    void execute(uint32_t program,
+                 ScaleDecoderStream &stream,
+                 Visitor &visitor,
+                 size_t depth) const;
+
+    // program 0 decodes the type the plan is compiled for
+    std::vector<std::vector<Instruction>> programs_;
+    std::vector<VariantTable> variant_tables_;
+  };
+
+}  // namespace scale::dynamic
+
+OUTCOME_HPP_DECLARE_ERROR_2(scale::dynamic, DynamicTypeError)
+
+#endif  // SCALE_CORE_SCALE_DYNAMIC_DECODER_HPP
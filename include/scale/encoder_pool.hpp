@@ -0,0 +1,65 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_ENCODER_POOL_HPP
+#define SCALE_CORE_SCALE_ENCODER_POOL_HPP
+
+#include <memory>
+
+#include <scale/scale_encoder_stream.hpp>
+
+namespace scale {
+
+  /**
+   * @class EncoderPool per-thread pool of encoder streams, which keep storage
+   * grown by previous encodings, so that encoding of values of steady size
+   * does not reallocate it
+   */
+  class EncoderPool {
+   public:
+    // streams taken at once by nested encodings, more are not kept
+    static constexpr size_t kMaxPooledStreams = 4;
+    // streams with larger storage are released rather than kept
+    static constexpr size_t kMaxRetainedCapacity = 1u << 20u;
+
+    /**
+     * @class Lease empty stream taken from the pool, which is reset and
+     * returned to the pool on destruction
+     */
+    class Lease {
+     public:
+      explicit Lease(std::unique_ptr<ScaleEncoderStream> stream)
+          : stream_{std::move(stream)} {}
+
+      Lease(const Lease &) = delete;
+      Lease &operator=(const Lease &) = delete;
+
+      ~Lease() {
+        release(std::move(stream_));
+      }
+
+      ScaleEncoderStream &operator*() const {
+        return *stream_;
+      }
+      ScaleEncoderStream *operator->() const {
+        return stream_.get();
+      }
+
+     private:
+      std::unique_ptr<ScaleEncoderStream> stream_;
+    };
+
+    /**
+     * @return stream from the pool of the calling thread or a new one
+     */
+    static Lease acquire();
+
+   private:
+    static void release(std::unique_ptr<ScaleEncoderStream> stream);
+  };
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_ENCODER_POOL_HPP
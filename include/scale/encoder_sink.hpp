@@ -0,0 +1,41 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_ENCODER_SINK_HPP
+#define SCALE_CORE_SCALE_ENCODER_SINK_HPP
+
+#include <cstdint>
+
+#include <gsl/span>
+
+namespace scale {
+
+  /**
+   * @class EncoderSink receives data encoded by ScaleEncoderStream instead of
+   * the stream's own storage
+   */
+  class EncoderSink {
+   public:
+    virtual ~EncoderSink() = default;
+
+    /**
+     * @brief consumes a chunk of encoded data
+     * @param bytes encoded data, valid only during the call
+     */
+    virtual void write(gsl::span<const uint8_t> bytes) = 0;
+
+    /**
+     * @brief consumes a byte range put by putReferencedBytes, which is handed
+     * over as is, without copying it to the stream buffer
+     * @param bytes encoded data, valid as long as its owner is alive
+     */
+    virtual void reference(gsl::span<const uint8_t> bytes) {
+      write(bytes);
+    }
+  };
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_ENCODER_SINK_HPP
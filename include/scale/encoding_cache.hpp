@@ -0,0 +1,209 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_ENCODING_CACHE_HPP
+#define SCALE_CORE_SCALE_ENCODING_CACHE_HPP
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include <scale/outcome/outcome.hpp>
+#include <scale/scale.hpp>
+
+namespace scale {
+
+  /**
+   * @class CachedEncoding immutable value, which is encoded once on first
+   * use and then put to streams as a byte range: copied into the stream
+   * buffer or passed to its sink by reference, so the object must outlive
+   * the data of the sink. Decoded values keep the bytes they were decoded
+   * from.
+   * @tparam T value type
+   */
+  template <class T>
+  class CachedEncoding {
+   public:
+    CachedEncoding() = default;
+
+    explicit CachedEncoding(T value) : value_{std::move(value)} {}
+
+    /**
+     * @param value value
+     * @param encoded encoding of the value, which is not checked
+     */
+    CachedEncoding(T value, ByteArray encoded)
+        : value_{std::move(value)},
+          encoded_{std::make_shared<const ByteArray>(std::move(encoded))} {}
+
+    const T &get() const {
+      return value_;
+    }
+    const T &operator*() const {
+      return value_;
+    }
+    const T *operator->() const {
+      return &value_;
+    }
+
+    /**
+     * @brief encodes the value on the first call, concurrent calls are safe
+     * @return encoded value, valid as long as this object is alive
+     */
+    gsl::span<const uint8_t> encoded() const {
+      auto encoded = std::atomic_load(&encoded_);
+      if (encoded == nullptr) {
+        // racing threads encode equal bytes, the first stored ones are kept
+        auto fresh = std::make_shared<const ByteArray>(encode(value_).value());
+        if (std::atomic_compare_exchange_strong(&encoded_, &encoded, fresh)) {
+          encoded = std::move(fresh);
+        }
+      }
+      return *encoded;
+    }
+
+    bool operator==(const CachedEncoding &other) const {
+      return value_ == other.value_;
+    }
+    bool operator!=(const CachedEncoding &other) const {
+      return not(*this == other);
+    }
+
+   private:
+    T value_;
+    mutable std::shared_ptr<const ByteArray> encoded_;
+  };
+
+  template <class Stream,
+            class T,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const CachedEncoding<T> &v) {
+    return s.putReferencedBytes(v.encoded());
+  }
+
+  template <class Stream,
+            class T,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, CachedEncoding<T> &v) {
+    auto begin = s.currentIndex();
+    T value{};
+    s >> value;
+    auto bytes = s.span().subspan(begin, s.currentIndex() - begin);
+    v = CachedEncoding<T>{std::move(value),
+                          ByteArray(bytes.begin(), bytes.end())};
+    return s;
+  }
+
+  /**
+   * @class EncodingCache keeps encodings of objects identified by address,
+   * type and version, so that encoding an unchanged object again is a
+   * lookup. Only the latest version of an object is kept. Entries are
+   * evicted in least recently used order when their total size exceeds the
+   * byte budget. The cache is split into shards with separate locks for
+   * concurrent use.
+   * @code{.cpp}
+   * EncodingCache cache{64u << 20u};
+   * OUTCOME_TRY(encoded, cache.encode(header, header_version));
+   * s.putBytes(*encoded);
+   * @endcode
+   */
+  class EncodingCache {
+   public:
+    static constexpr size_t kDefaultShards = 16;
+
+    struct Key {
+      // a struct and its first field share the address, so objects are
+      // told apart by type as well
+      const void *object;
+      std::type_index type;
+      uint64_t version;
+    };
+
+    using Entry = std::shared_ptr<const ByteArray>;
+
+    /**
+     * @param byte_budget limit of total size of cached encodings
+     * @param shards number of independently locked parts, each holding an
+     * equal part of the budget
+     */
+    explicit EncodingCache(size_t byte_budget,
+                           size_t shards = kDefaultShards);
+
+    /**
+     * @brief takes the cached encoding of the object or encodes and caches
+     * it. The object is identified by its address, so it must be given a new
+     * version when it changes, or erased from the cache when destroyed, or
+     * another object may take its address and encoding. Caching a version
+     * drops the older one, and older versions are not cached.
+     * @param value object to encode
+     * @param version version of the object, which grows as it changes
+     * @return encoding, which stays valid after eviction
+     */
+    template <class T>
+    outcome::result<Entry> encode(const T &value, uint64_t version) {
+      Key key{&value, typeid(T), version};
+      auto &shard = shardOf(key.object);
+      if (auto entry = shard.find(key)) {
+        return entry;
+      }
+      OUTCOME_TRY(encoded, scale::encode(value));
+      auto entry = std::make_shared<const ByteArray>(std::move(encoded));
+      shard.insert(key, entry);
+      return entry;
+    }
+
+    /**
+     * @brief removes encodings of the object and of objects of other types
+     * at its address, which are kept together in a single shard
+     */
+    void erase(const void *object);
+
+    /**
+     * @return total size of cached encodings
+     */
+    size_t size() const;
+
+    void clear();
+
+   private:
+    class Shard {
+     public:
+      explicit Shard(size_t byte_budget) : byte_budget_{byte_budget} {}
+
+      Entry find(const Key &key);
+      void insert(const Key &key, Entry entry);
+      void erase(const void *object);
+      size_t size() const;
+      void clear();
+
+     private:
+      using Lru = std::list<std::pair<Key, Entry>>;
+      // entries of an object, one for each type it is cached as
+      using ObjectEntries = std::vector<Lru::iterator>;
+
+      // removes the entry from the list and from the entries of its object
+      void remove(ObjectEntries &entries, ObjectEntries::iterator it);
+
+      mutable std::mutex mutex_;
+      size_t byte_budget_;
+      size_t size_ = 0;
+      // the most recently used entries are at the front
+      Lru lru_;
+      std::unordered_map<const void *, ObjectEntries> index_;
+    };
+
+    // all the entries of an object go to the same shard, which replaces
+    // their versions and erases them at once
+    Shard &shardOf(const void *object);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+  };
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_ENCODING_CACHE_HPP
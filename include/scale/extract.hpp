@@ -0,0 +1,206 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_EXTRACT_HPP
+#define SCALE_CORE_SCALE_EXTRACT_HPP
+
+#include <gsl/span>
+
+#include <scale/outcome/outcome.hpp>
+#include <scale/skip.hpp>
+
+namespace scale {
+
+  /**
+   * @brief ExtractError enum provides error codes for field extraction
+   */
+  enum class ExtractError {
+    ARM_MISMATCH = 1,    ///< variant holds another arm than the path expects
+    INDEX_OUT_OF_RANGE,  ///< collection has fewer elements than the index
+  };
+
+  /**
+   * Steps of a path through a static type to a part of its encoded value
+   * @code{.cpp}
+   * // field 3 of the block, element i of the vector, arm 2 of the variant,
+   * // field 0 of the arm
+   * auto account = scale::extract<Block>(encoded,
+   *                                      path::field<3>,
+   *                                      path::element(i),
+   *                                      path::arm<2>,
+   *                                      path::field<0>);
+   * @endcode
+   */
+  namespace path {
+    /// field of a pair, tuple or struct described with SCALE_TIE
+    template <size_t I>
+    struct Field {};
+
+    /// element of a collection or array
+    struct Element {
+      size_t index;
+    };
+
+    /// arm of a variant, arm 1 of an optional is its value
+    template <size_t I>
+    struct Arm {};
+
+    template <size_t I>
+    constexpr Field<I> field{};
+
+    template <size_t I>
+    constexpr Arm<I> arm{};
+
+    inline Element element(size_t index) {
+      return Element{index};
+    }
+  }  // namespace path
+
+  namespace detail {
+    template <class T, size_t I>
+    struct ArmType;
+
+    template <class... Ts, size_t I>
+    struct ArmType<boost::variant<Ts...>, I> {
+      using type = std::tuple_element_t<I, std::tuple<Ts...>>;
+    };
+
+    template <class T, size_t I>
+    struct ArmType<std::optional<T>, I> {
+      static_assert(I == 1, "only arm 1 of optional has a value");
+      static_assert(not std::is_same_v<T, bool>,
+                    "optional bool is encoded as a single byte");
+      using type = T;
+    };
+
+    // maps are encoded as sequences of pairs
+    template <class T, typename = void>
+    struct ElementType {
+      using type = std::remove_const_t<typename T::value_type>;
+    };
+
+    template <class T>
+    struct ElementType<
+        T,
+        std::enable_if_t<ScaleDecoderStream::is_map_like<T>::value>> {
+      using type = std::pair<typename T::key_type, typename T::mapped_type>;
+    };
+
+    template <class T, class... Steps>
+    struct PathTarget {
+      using type = T;
+    };
+
+    template <class T, size_t I, class... Rest>
+    struct PathTarget<T, path::Field<I>, Rest...>
+        : PathTarget<std::tuple_element_t<I, field_types_t<T>>, Rest...> {};
+
+    template <class T, class... Rest>
+    struct PathTarget<T, path::Element, Rest...>
+        : PathTarget<typename ElementType<T>::type, Rest...> {};
+
+    template <class T, size_t I, class... Rest>
+    struct PathTarget<T, path::Arm<I>, Rest...>
+        : PathTarget<typename ArmType<T, I>::type, Rest...> {};
+
+    template <class T>
+    void locate(ScaleDecoderStream & /*unused*/) {}
+
+    template <class T, size_t I, class... Rest>
+    void locate(ScaleDecoderStream &s, path::Field<I> /*unused*/, Rest... rest);
+
+    template <class T, class... Rest>
+    void locate(ScaleDecoderStream &s, path::Element element, Rest... rest);
+
+    template <class T, size_t I, class... Rest>
+    void locate(ScaleDecoderStream &s, path::Arm<I> /*unused*/, Rest... rest);
+
+    template <class T, size_t I, class... Rest>
+    void locate(ScaleDecoderStream &s,
+                path::Field<I> /*unused*/,
+                Rest... rest) {
+      using Fields = field_types_t<T>;
+      skipFields<Fields>(s, std::make_index_sequence<I>{});
+      locate<std::tuple_element_t<I, Fields>>(s, rest...);
+    }
+
+    template <class T, class... Rest>
+    void locate(ScaleDecoderStream &s, path::Element element, Rest... rest) {
+      using E = typename ElementType<T>::type;
+      size_t count = 0;
+      if constexpr (is_std_array<T>::value) {
+        count = std::tuple_size_v<T>;
+      } else {
+        count = decodeLength(s);
+      }
+      if (element.index >= count) {
+        raise(ExtractError::INDEX_OUT_OF_RANGE);
+      }
+      skipElements<E>(s, element.index);
+      locate<E>(s, rest...);
+    }
+
+    template <class T, size_t I, class... Rest>
+    void locate(ScaleDecoderStream &s,
+                path::Arm<I> /*unused*/,
+                Rest... rest) {
+      if (s.nextByte() != I) {
+        raise(ExtractError::ARM_MISMATCH);
+      }
+      locate<typename ArmType<T, I>::type>(s, rest...);
+    }
+  }  // namespace detail
+
+  /// type of the value at the end of the path
+  template <class T, class... Steps>
+  using path_target_t = typename detail::PathTarget<T, Steps...>::type;
+
+  /**
+   * @brief finds encoded value at the path, skipping everything before it
+   * @tparam T type of the encoded value
+   * @param encoded encoded value
+   * @param steps path to the target
+   * @return span of the encoded target within encoded data
+   */
+  template <class T, class... Steps>
+  outcome::result<gsl::span<const uint8_t>> extractBytes(
+      gsl::span<const uint8_t> encoded, Steps... steps) {
+    ScaleDecoderStream s{encoded};
+    try {
+      detail::locate<T>(s, steps...);
+      auto begin = s.currentIndex();
+      skip<path_target_t<T, Steps...>>(s);
+      return encoded.subspan(begin, s.currentIndex() - begin);
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+  }
+
+  /**
+   * @brief decodes only the value at the path, skipping everything before it
+   * @tparam T type of the encoded value
+   * @param encoded encoded value
+   * @param steps path to the target
+   * @return decoded target
+   */
+  template <class T, class... Steps>
+  outcome::result<path_target_t<T, Steps...>> extract(
+      gsl::span<const uint8_t> encoded, Steps... steps) {
+    ScaleDecoderStream s{encoded};
+    path_target_t<T, Steps...> value{};
+    try {
+      detail::locate<T>(s, steps...);
+      s >> value;
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return value;
+  }
+
+}  // namespace scale
+
+OUTCOME_HPP_DECLARE_ERROR_2(scale, ExtractError)
+
+#endif  // SCALE_CORE_SCALE_EXTRACT_HPP
@@ -0,0 +1,125 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_HASHING_SINKS_HPP
+#define SCALE_CORE_SCALE_HASHING_SINKS_HPP
+
+#include <array>
+
+#include <scale/encoder_sink.hpp>
+#include <scale/outcome/outcome.hpp>
+#include <scale/scale_encoder_stream.hpp>
+
+namespace scale {
+
+  /**
+   * Buffer size of ScaleEncoderStream used for hashing, small enough to stay
+   * in L1 cache and large enough for the hash to process whole blocks
+   */
+  constexpr size_t kHashingBufferSize = 512;
+
+  /**
+   * @class Blake2b256Sink computes BLAKE2b hash with 32 bytes output of the
+   * encoded data
+   */
+  class Blake2b256Sink final : public EncoderSink {
+   public:
+    using Hash = std::array<uint8_t, 32>;
+
+    Blake2b256Sink();
+
+    void write(gsl::span<const uint8_t> bytes) override;
+
+    /**
+     * @return hash of all the data written, the sink must not be used after
+     */
+    Hash finish();
+
+   private:
+    static constexpr size_t kBlockSize = 128;
+
+    // size is the number of data bytes in the block, the rest is padding
+    void compress(const uint8_t *block, size_t size, bool last);
+
+    std::array<uint64_t, 8> state_;
+    // number of bytes compressed so far
+    uint64_t counter_;
+    // the last block is kept until finish() since it is compressed
+    // differently
+    std::array<uint8_t, kBlockSize> block_;
+    size_t block_size_;
+  };
+
+  /**
+   * @class XxHash64Sink computes 64-bit xxHash of the encoded data
+   */
+  class XxHash64Sink final : public EncoderSink {
+   public:
+    using Hash = uint64_t;
+
+    explicit XxHash64Sink(uint64_t seed = 0);
+
+    void write(gsl::span<const uint8_t> bytes) override;
+
+    /**
+     * @return hash of all the data written
+     */
+    Hash finish() const;
+
+   private:
+    static constexpr size_t kStripeSize = 32;
+
+    uint64_t seed_;
+    std::array<uint64_t, 4> accumulators_;
+    uint64_t total_size_;
+    std::array<uint8_t, kStripeSize> stripe_;
+    size_t stripe_size_;
+  };
+
+  /**
+   * @class Twox128Sink computes Twox128 hash used for storage keys: xxHash64
+   * with seeds 0 and 1, concatenated as little-endian numbers
+   */
+  class Twox128Sink final : public EncoderSink {
+   public:
+    using Hash = std::array<uint8_t, 16>;
+
+    Twox128Sink();
+
+    void write(gsl::span<const uint8_t> bytes) override;
+
+    /**
+     * @return hash of all the data written
+     */
+    Hash finish() const;
+
+   private:
+    XxHash64Sink first_;
+    XxHash64Sink second_;
+  };
+
+  /**
+   * @brief hashes encoded values without materializing the encoded data
+   * @tparam Sink hashing sink
+   * @tparam Args types of values to be encoded
+   * @param args values to encode
+   * @return hash of the encoded data
+   */
+  template <class Sink, typename... Args>
+  outcome::result<typename Sink::Hash> hashEncoded(Args &&... args) {
+    Sink sink;
+    try {
+      ScaleEncoderStream s{sink, kHashingBufferSize};
+      (s << ... << std::forward<Args>(args));
+      s.flush();
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return sink.finish();
+  }
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_HASHING_SINKS_HPP
@@ -0,0 +1,203 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_INTERN_TABLE_HPP
+#define SCALE_CORE_SCALE_INTERN_TABLE_HPP
+
+#include <array>
+#include <memory>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+
+#include <gsl/span>
+
+#include <scale/scale_decoder_stream.hpp>
+#include <scale/scale_error.hpp>
+
+namespace scale {
+
+  namespace detail {
+    // byte strings are length-prefixed, byte arrays are not
+    template <class T>
+    constexpr bool kIsByteString =
+        std::is_constructible_v<T, const uint8_t *, const uint8_t *>;
+  }  // namespace detail
+
+  /**
+   * @class Interned shared immutable handle to a byte string or fixed byte
+   * array. Values decoded with the same InternTable share one copy.
+   * @tparam T std::vector<uint8_t>, std::string, Buffer or
+   * std::array<uint8_t, N>
+   */
+  template <class T>
+  class Interned {
+   public:
+    /// empty value, shared by all default-constructed handles
+    Interned() : value_{empty()} {}
+
+    explicit Interned(std::shared_ptr<const T> value)
+        : value_{std::move(value)} {}
+
+    const T &get() const {
+      return *value_;
+    }
+    const T &operator*() const {
+      return *value_;
+    }
+    const T *operator->() const {
+      return value_.get();
+    }
+
+    /// interned copies of equal values are compared by address
+    bool operator==(const Interned &other) const {
+      return value_ == other.value_ or *value_ == *other.value_;
+    }
+    bool operator!=(const Interned &other) const {
+      return not(*this == other);
+    }
+
+   private:
+    // containers of handles are resized before decoding into them, which
+    // allocates nothing with a shared empty value
+    static const std::shared_ptr<const T> &empty() {
+      static const auto kEmpty = std::make_shared<const T>();
+      return kEmpty;
+    }
+
+    std::shared_ptr<const T> value_;
+  };
+
+  /**
+   * @class InternTable keeps one copy of each distinct small value decoded
+   * as Interned<T> by streams it is set to with
+   * ScaleDecoderStream::setInternTable
+   */
+  class InternTable {
+   public:
+    // fits account ids, hashes and short names
+    static constexpr size_t kDefaultMaxValueSize = 64;
+
+    /**
+     * @param max_value_size values of larger size are not interned
+     */
+    explicit InternTable(size_t max_value_size = kDefaultMaxValueSize)
+        : max_value_size_{max_value_size} {}
+
+    /**
+     * @brief finds a value with the given content or adds a new one
+     * @tparam T value type
+     * @param bytes content of the value
+     * @return handle to the shared value
+     */
+    template <class T>
+    Interned<T> intern(gsl::span<const uint8_t> bytes) {
+      if (static_cast<size_t>(bytes.size()) > max_value_size_) {
+        return copy<T>(bytes);
+      }
+      auto &values = values_[std::type_index{typeid(T)}];
+      if (auto it = values.find(toKey(bytes.data(), bytes.size()));
+          it != values.end()) {
+        return Interned<T>{std::static_pointer_cast<const T>(it->second)};
+      }
+      auto value = make<T>(bytes);
+      // the key refers to the content of the value itself
+      values.emplace(toKey(value->data(), value->size()), value);
+      return Interned<T>{std::move(value)};
+    }
+
+    /**
+     * @brief makes a handle to a new value, not shared with other ones
+     * @tparam T value type
+     * @param bytes content of the value
+     */
+    template <class T>
+    static Interned<T> copy(gsl::span<const uint8_t> bytes) {
+      return Interned<T>{make<T>(bytes)};
+    }
+
+    /**
+     * @return number of distinct values in the table
+     */
+    size_t size() const {
+      size_t size = 0;
+      for (const auto &values : values_) {
+        size += values.second.size();
+      }
+      return size;
+    }
+
+    /**
+     * @brief forgets all the values, handles stay valid
+     */
+    void clear() {
+      values_.clear();
+    }
+
+   private:
+    template <class T>
+    static std::shared_ptr<const T> make(gsl::span<const uint8_t> bytes) {
+      const auto *begin = bytes.data();
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const auto *end = begin + bytes.size();
+      if constexpr (detail::kIsByteString<T>) {
+        return std::make_shared<const T>(begin, end);
+      } else {
+        T value{};
+        std::copy(begin, end, value.begin());
+        return std::make_shared<const T>(value);
+      }
+    }
+
+    template <class Byte>
+    static std::string_view toKey(const Byte *data, size_t size) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      return {reinterpret_cast<const char *>(data), size};
+    }
+
+    size_t max_value_size_;
+    std::unordered_map<
+        std::type_index,
+        std::unordered_map<std::string_view, std::shared_ptr<const void>>>
+        values_;
+  };
+
+  /**
+   * @brief decodes value, sharing it with equal values decoded before if the
+   * stream has an intern table
+   */
+  template <class Stream,
+            class T,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, Interned<T> &v) {
+    gsl::span<const uint8_t> bytes;
+    if constexpr (detail::kIsByteString<T>) {
+      CompactInteger size;
+      s >> size;
+      if (not s.hasMore(size.convert_to<uint64_t>())) {
+        raise(DecodeError::NOT_ENOUGH_DATA);
+      }
+      bytes = s.nextBytes(size.convert_to<typename Stream::SizeType>());
+    } else {
+      static_assert(sizeof(T) == std::tuple_size_v<T>,
+                    "only byte arrays can be interned");
+      bytes = s.nextBytes(std::tuple_size_v<T>);
+    }
+    auto *table = s.internTable();
+    v = table != nullptr ? table->template intern<T>(bytes)
+                         : InternTable::copy<T>(bytes);
+    return s;
+  }
+
+  template <class Stream,
+            class T,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const Interned<T> &v) {
+    return s << v.get();
+  }
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_INTERN_TABLE_HPP
@@ -0,0 +1,186 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_JAGGED_BYTES_HPP
+#define SCALE_CORE_SCALE_JAGGED_BYTES_HPP
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <gsl/span>
+
+#include <scale/detail/compact_batch.hpp>
+#include <scale/outcome/outcome_throw.hpp>
+#include <scale/scale_decoder_stream.hpp>
+#include <scale/scale_encoder_stream.hpp>
+#include <scale/skip.hpp>
+
+namespace scale {
+
+  /**
+   * @class JaggedBytes collection of byte arrays encoded as Vec<Vec<u8>>,
+   * which keeps all the arrays one after another in a single buffer with
+   * offsets of their ends. Decoding it makes two allocations regardless of
+   * the number of arrays: the first pass reads and checks the lengths, the
+   * second one copies the arrays. Encoding puts the arrays as byte ranges.
+   */
+  class JaggedBytes {
+   public:
+    JaggedBytes() = default;
+
+    explicit JaggedBytes(const std::vector<ByteArray> &arrays) {
+      size_t total = 0;
+      for (const auto &array : arrays) {
+        total += array.size();
+      }
+      reserve(arrays.size(), total);
+      for (const auto &array : arrays) {
+        push_back(array);
+      }
+    }
+
+    size_t size() const {
+      return ends_.size();
+    }
+
+    bool empty() const {
+      return ends_.empty();
+    }
+
+    /**
+     * @param index index of the array, less than size()
+     * @return bytes of the array, valid until the collection is changed
+     */
+    gsl::span<const uint8_t> operator[](size_t index) const {
+      BOOST_ASSERT(index < ends_.size());
+      size_t begin = index == 0 ? 0 : ends_[index - 1];
+      return gsl::span<const uint8_t>(data_).subspan(begin,
+                                                     ends_[index] - begin);
+    }
+
+    /**
+     * @return bytes of all the arrays one after another
+     */
+    gsl::span<const uint8_t> data() const {
+      return data_;
+    }
+
+    void reserve(size_t arrays, size_t bytes) {
+      ends_.reserve(arrays);
+      data_.reserve(bytes);
+    }
+
+    void push_back(gsl::span<const uint8_t> array) {
+      BOOST_ASSERT(data_.size() + array.size()
+                   <= std::numeric_limits<uint32_t>::max());
+      data_.insert(data_.end(), array.begin(), array.end());
+      ends_.push_back(static_cast<uint32_t>(data_.size()));
+    }
+
+    void clear() {
+      data_.clear();
+      ends_.clear();
+    }
+
+    /**
+     * @return copies of the arrays
+     */
+    std::vector<ByteArray> toVectors() const {
+      std::vector<ByteArray> arrays;
+      arrays.reserve(size());
+      for (size_t i = 0; i < size(); ++i) {
+        auto array = (*this)[i];
+        arrays.emplace_back(array.begin(), array.end());
+      }
+      return arrays;
+    }
+
+    bool operator==(const JaggedBytes &other) const {
+      return ends_ == other.ends_ and data_ == other.data_;
+    }
+    bool operator!=(const JaggedBytes &other) const {
+      return not(*this == other);
+    }
+
+    friend ScaleEncoderStream &operator<<(ScaleEncoderStream &s,
+                                          const JaggedBytes &v) {
+      s << CompactInteger{v.size()};
+      for (size_t i = 0; i < v.size(); ++i) {
+        auto array = v[i];
+        s << Compact<uint32_t>{static_cast<uint32_t>(array.size())};
+        s.putBytes(array);
+      }
+      return s;
+    }
+
+    friend ScaleDecoderStream &operator>>(ScaleDecoderStream &s,
+                                          JaggedBytes &v) {
+      auto count = detail::decodeLength(s);
+      // each array takes at least a byte of its length
+      if (not s.hasMore(count)) {
+        raise(DecodeError::NOT_ENOUGH_DATA);
+      }
+      auto encoded = s.span().subspan(s.currentIndex());
+      auto available = static_cast<size_t>(encoded.size());
+
+      std::vector<uint32_t> ends(count);
+      size_t position = 0;
+      size_t total = 0;
+      for (auto &end : ends) {
+        uint32_t length = 0;
+        auto header =
+            detail::decodeCompactValue(encoded.subspan(position), length);
+        if (not header) {
+          raise(header.error());
+        }
+        position += header.value();
+        if (length > available - position) {
+          raise(DecodeError::NOT_ENOUGH_DATA);
+        }
+        position += length;
+        total += length;
+        if (total > std::numeric_limits<uint32_t>::max()) {
+          raise(DecodeError::TOO_MANY_ITEMS);
+        }
+        end = static_cast<uint32_t>(total);
+      }
+
+      ByteArray data(total);
+      position = 0;
+      size_t begin = 0;
+      for (auto end : ends) {
+        uint32_t length = 0;
+        position += detail::decodeCompactValue(encoded.subspan(position),
+                                               length)
+                        .value();
+        if (length != 0) {
+          std::memcpy(
+              // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+              data.data() + begin,
+              // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+              encoded.data() + position,
+              length);
+        }
+        position += length;
+        begin = end;
+      }
+      s.nextBytes(position);
+
+      v.data_ = std::move(data);
+      v.ends_ = std::move(ends);
+      return s;
+    }
+
+   private:
+    ByteArray data_;
+    // offsets of the ends of the arrays in data_
+    std::vector<uint32_t> ends_;
+  };
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_JAGGED_BYTES_HPP
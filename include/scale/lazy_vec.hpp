@@ -0,0 +1,176 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_LAZY_VEC_HPP
+#define SCALE_CORE_SCALE_LAZY_VEC_HPP
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <scale/outcome/outcome.hpp>
+#include <scale/scale.hpp>
+#include <scale/skip.hpp>
+
+namespace scale {
+
+  /**
+   * @class LazyVec vector encoded as Vec<T>, which keeps its encoded
+   * elements and decodes them on access. Decoding it skips the elements,
+   * remembering where each of them starts unless they are of static size;
+   * encoding it copies the kept bytes out.
+   * @tparam T element type
+   */
+  template <class T>
+  class LazyVec {
+   public:
+    LazyVec() = default;
+
+    explicit LazyVec(const std::vector<T> &elements) {
+      ScaleEncoderStream s;
+      for (const auto &element : elements) {
+        if constexpr (not kStaticSize<T>.has_value()) {
+          offsets_.push_back(static_cast<uint32_t>(s.size()));
+        }
+        s << element;
+      }
+      bytes_ = s.to_vector();
+      size_ = elements.size();
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    /**
+     * @return encoded elements without the length
+     */
+    gsl::span<const uint8_t> encodedElements() const {
+      return bytes_;
+    }
+
+    /**
+     * @brief decodes the element, which is not cached
+     * @param index index of the element, less than size()
+     * @return decoded element or error
+     */
+    outcome::result<T> get(size_t index) const {
+      BOOST_ASSERT(index < size_);
+      return decode<T>(elementBytes(index));
+    }
+
+    /**
+     * @brief decodes the element on the first access and keeps it
+     * @param index index of the element, less than size()
+     * @return pointer to the decoded element, valid as long as this vector
+     * is alive and not assigned, or error
+     */
+    outcome::result<const T *> getCached(size_t index) {
+      BOOST_ASSERT(index < size_);
+      if constexpr (kStaticSize<T> == 0) {
+        // elements of zero size are decoded equally, while their count is
+        // not bounded by the data, so a single one is kept for all of them
+        index = 0;
+      }
+      if (cache_.empty()) {
+        cache_.resize(kStaticSize<T> == 0 ? 1 : size_);
+      }
+      auto &cached = cache_[index];
+      if (not cached) {
+        OUTCOME_TRY(element, get(index));
+        cached.emplace(std::move(element));
+      }
+      return &*cached;
+    }
+
+    /**
+     * @return all the elements decoded or error
+     */
+    outcome::result<std::vector<T>> decodeAll() const {
+      std::vector<T> elements;
+      elements.reserve(size_);
+      ScaleDecoderStream s{bytes_};
+      try {
+        for (size_t i = 0; i < size_; ++i) {
+          T element{};
+          s >> element;
+          elements.emplace_back(std::move(element));
+        }
+      } catch (std::system_error &e) {
+        return outcome::failure(e.code());
+      }
+      return elements;
+    }
+
+    /// vectors of equal elements are encoded equally
+    bool operator==(const LazyVec &other) const {
+      return size_ == other.size_ and bytes_ == other.bytes_;
+    }
+    bool operator!=(const LazyVec &other) const {
+      return not(*this == other);
+    }
+
+    template <class Stream,
+              typename = std::enable_if_t<Stream::is_decoder_stream>>
+    friend Stream &operator>>(Stream &s, LazyVec &v) {
+      auto size = detail::decodeLength(s);
+      auto begin = s.currentIndex();
+      std::vector<uint32_t> offsets;
+      if constexpr (kStaticSize<T>.has_value()) {
+        detail::skipElements<T>(s, size);
+      } else {
+        // elements are not counted on before they are skipped
+        offsets.reserve(std::min<size_t>(size, s.span().size() - begin));
+        for (size_t i = 0; i < size; ++i) {
+          auto offset = s.currentIndex() - begin;
+          if (offset > std::numeric_limits<uint32_t>::max()) {
+            raise(DecodeError::TOO_MANY_ITEMS);
+          }
+          offsets.push_back(static_cast<uint32_t>(offset));
+          skip<T>(s);
+        }
+      }
+      auto bytes = s.span().subspan(begin, s.currentIndex() - begin);
+      v.bytes_.assign(bytes.begin(), bytes.end());
+      v.offsets_ = std::move(offsets);
+      v.size_ = size;
+      v.cache_.clear();
+      return s;
+    }
+
+    template <class Stream,
+              typename = std::enable_if_t<Stream::is_encoder_stream>>
+    friend Stream &operator<<(Stream &s, const LazyVec &v) {
+      s << CompactInteger{v.size_};
+      return s.putBytes(v.bytes_);
+    }
+
+   private:
+    gsl::span<const uint8_t> elementBytes(size_t index) const {
+      gsl::span<const uint8_t> bytes{bytes_};
+      if constexpr (kStaticSize<T>.has_value()) {
+        return bytes.subspan(index * *kStaticSize<T>, *kStaticSize<T>);
+      } else {
+        auto end = index + 1 < size_ ? offsets_[index + 1] : bytes_.size();
+        return bytes.subspan(offsets_[index], end - offsets_[index]);
+      }
+    }
+
+    ByteArray bytes_;
+    // offsets of elements in bytes_, when they are not of static size
+    std::vector<uint32_t> offsets_;
+    size_t size_ = 0;
+    std::vector<std::optional<T>> cache_;
+  };
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_LAZY_VEC_HPP
@@ -0,0 +1,178 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_MAPPED_RECORD_READER_HPP
+#define SCALE_CORE_SCALE_MAPPED_RECORD_READER_HPP
+
+#include <iterator>
+#include <optional>
+#include <string>
+
+#include <gsl/span>
+
+#include <scale/outcome/outcome.hpp>
+#include <scale/scale_decoder_stream.hpp>
+#include <scale/scale_error.hpp>
+
+namespace scale {
+
+  /**
+   * @class MappedFile read-only memory mapping of a whole file
+   */
+  class MappedFile {
+   public:
+    /**
+     * @brief maps file to memory
+     * @param path path to the file
+     * @return mapped file or system error
+     */
+    static outcome::result<MappedFile> open(const std::string &path);
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    /**
+     * @return mapped content of the file
+     */
+    gsl::span<const uint8_t> data() const;
+
+    /**
+     * @brief hints the kernel that the file is going to be read sequentially,
+     * so pages are read ahead aggressively and dropped soon after access
+     */
+    void adviseSequential() const;
+
+   private:
+    MappedFile(const uint8_t *data, size_t size);
+
+    /// unmaps the file, leaving the object empty
+    void reset();
+
+    const uint8_t *data_;
+    size_t size_;
+  };
+
+  /**
+   * @class MappedRecordReader iterates over a file of concatenated SCALE
+   * records without reading it to memory. Records either are byte vectors
+   * (compact length prefixed), taken as spans over the mapping and decoded
+   * lazily by the caller, or self-delimiting values decoded in place.
+   */
+  class MappedRecordReader {
+   public:
+    class Iterator;
+
+    /**
+     * @brief maps file with records
+     * @param path path to the file
+     * @param sequential whether to advise the kernel of sequential reading
+     * @return reader or system error
+     */
+    static outcome::result<MappedRecordReader> open(const std::string &path,
+                                                    bool sequential = true);
+
+    /**
+     * @brief takes next length prefixed record
+     * @return record content without length prefix, std::nullopt at the end
+     * of the file, or DecodeError::NOT_ENOUGH_DATA for a truncated record
+     */
+    outcome::result<std::optional<gsl::span<const uint8_t>>> nextRecord();
+
+    /**
+     * @brief decodes next self-delimiting record
+     * @tparam T type of the record
+     * @return decoded record, std::nullopt at the end of the file or decoding
+     * error
+     */
+    template <class T>
+    outcome::result<std::optional<T>> next() {
+      if (atEnd()) {
+        return std::nullopt;
+      }
+      T t{};
+      try {
+        stream_ >> t;
+      } catch (std::system_error &e) {
+        return outcome::failure(e.code());
+      }
+      return std::optional<T>{std::move(t)};
+    }
+
+    /**
+     * @return true if all the records are read
+     */
+    bool atEnd() const;
+
+    /**
+     * @return offset of the next record in the file
+     */
+    size_t offset() const;
+
+    /**
+     * @brief starts reading from the first record again
+     */
+    void rewind();
+
+    /**
+     * @return content of the whole file
+     */
+    gsl::span<const uint8_t> data() const;
+
+    /**
+     * Iteration over length prefixed records, starting from the current
+     * position. Truncated record is reported with std::system_error.
+     */
+    Iterator begin();
+    Iterator end();
+
+   private:
+    explicit MappedRecordReader(MappedFile file);
+
+    MappedFile file_;
+    ScaleDecoderStream stream_;
+  };
+
+  class MappedRecordReader::Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = gsl::span<const uint8_t>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    reference operator*() const {
+      return *record_;
+    }
+
+    pointer operator->() const {
+      return &*record_;
+    }
+
+    Iterator &operator++();
+
+    bool operator==(const Iterator &other) const {
+      return record_.has_value() == other.record_.has_value()
+             and (not record_ or record_->data() == other.record_->data());
+    }
+
+    bool operator!=(const Iterator &other) const {
+      return not(*this == other);
+    }
+
+   private:
+    friend class MappedRecordReader;
+
+    explicit Iterator(MappedRecordReader *reader);
+
+    MappedRecordReader *reader_;
+    std::optional<value_type> record_;
+  };
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_MAPPED_RECORD_READER_HPP
@@ -0,0 +1,199 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_RECORD_LOG_HPP
+#define SCALE_CORE_SCALE_RECORD_LOG_HPP
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gsl/span>
+
+#include <scale/mapped_record_reader.hpp>
+#include <scale/outcome/outcome.hpp>
+#include <scale/scale.hpp>
+
+namespace scale {
+
+  /**
+   * @brief RecordLogError enum provides error codes for record log methods
+   */
+  enum class RecordLogError {
+    CHECKSUM_MISMATCH = 1,  ///< record data does not match its checksum
+    INDEX_OUT_OF_RANGE,     ///< there is no record with the given number
+    INDEX_CORRUPTED,        ///< index points outside the data file
+  };
+
+  /**
+   * Append-only log of SCALE records. Each record in the data file is
+   * framed as
+   *   compact length | encoded value | CRC32C of the preceding bytes (u32 LE)
+   * and the sidecar index file (data file path + ".idx") holds u64 LE
+   * offsets of the records, allowing random access by record number.
+   */
+  class RecordLogWriter {
+   public:
+    struct Options {
+      // encoded records are collected in a buffer of this size before
+      // being written to the file
+      size_t buffer_size = 1u << 20u;
+      // number of records, after which written data is made durable with
+      // fdatasync; 0 means only on explicit sync()
+      size_t group_commit_records = 0;
+    };
+
+    /**
+     * @brief opens or creates log files for appending
+     * @param path path to the data file
+     * @param options writer options
+     * @return writer or system error
+     */
+    static outcome::result<RecordLogWriter> open(const std::string &path,
+                                                 Options options);
+
+    static outcome::result<RecordLogWriter> open(const std::string &path) {
+      return open(path, Options{});
+    }
+
+    RecordLogWriter(RecordLogWriter &&other) noexcept;
+    RecordLogWriter &operator=(RecordLogWriter &&) = delete;
+    RecordLogWriter(const RecordLogWriter &) = delete;
+    RecordLogWriter &operator=(const RecordLogWriter &) = delete;
+
+    /**
+     * Writes buffered records, but does not sync them
+     */
+    ~RecordLogWriter();
+
+    /**
+     * @brief encodes value directly into the write buffer as a new record.
+     * A failed append, including a failed flush of the buffer, leaves
+     * neither the record nor its index entry in the log.
+     * @tparam T value type
+     * @param value value to append
+     * @return number of the record or error
+     */
+    template <class T>
+    outcome::result<uint64_t> append(const T &value) {
+      auto record_offset = beginRecord();
+      // the stream takes the buffer as its storage and encodes after it
+      ScaleEncoderStream s;
+      s.swapBuffer(buffer_);
+      try {
+        s << value;
+      } catch (std::system_error &e) {
+        s.swapBuffer(buffer_);
+        buffer_.resize(record_offset);
+        return outcome::failure(e.code());
+      }
+      s.swapBuffer(buffer_);
+      return finishRecord(record_offset);
+    }
+
+    /**
+     * @brief writes buffered records to the files. On failure partially
+     * written data is truncated and the records stay buffered.
+     */
+    outcome::result<void> flush();
+
+    /**
+     * @brief writes buffered records and makes them durable
+     */
+    outcome::result<void> sync();
+
+    /**
+     * @return number of records in the log, including buffered ones
+     */
+    uint64_t size() const;
+
+   private:
+    RecordLogWriter(int data_fd, int index_fd, uint64_t data_size,
+                    uint64_t records, Options options);
+
+    // reserves space for the record length and returns record offset
+    // in the buffer
+    size_t beginRecord();
+
+    // frames the record encoded after the reserved space
+    outcome::result<uint64_t> finishRecord(size_t record_offset);
+
+    int data_fd_;
+    int index_fd_;
+    Options options_;
+    // size of the data file, not including the buffer
+    uint64_t data_size_;
+    uint64_t records_;
+    size_t unsynced_records_;
+    std::vector<uint8_t> buffer_;
+    std::vector<uint8_t> index_buffer_;
+  };
+
+  /**
+   * Reader of the log written by RecordLogWriter, checks records' checksums
+   */
+  class RecordLogReader {
+   public:
+    /**
+     * @brief maps log files
+     * @param path path to the data file
+     * @return reader or system error
+     */
+    static outcome::result<RecordLogReader> open(const std::string &path);
+
+    /**
+     * @return number of indexed records
+     */
+    uint64_t size() const;
+
+    /**
+     * @brief random access to the record by its number using the index
+     * @param n record number
+     * @return verified encoded value of the record
+     */
+    outcome::result<gsl::span<const uint8_t>> at(uint64_t n) const;
+
+    /**
+     * @brief decodes the record with given number
+     * @tparam T record value type
+     * @param n record number
+     * @return decoded value or error
+     */
+    template <class T>
+    outcome::result<T> get(uint64_t n) const {
+      OUTCOME_TRY(bytes, at(n));
+      return decode<T>(bytes);
+    }
+
+    /**
+     * @brief sequential reading, which does not need the index
+     * @return verified encoded value of the next record or std::nullopt at
+     * the end of the log
+     */
+    outcome::result<std::optional<gsl::span<const uint8_t>>> next();
+
+    /**
+     * @brief starts sequential reading from the first record again
+     */
+    void rewind();
+
+   private:
+    RecordLogReader(MappedFile data, MappedFile index);
+
+    // reads and verifies the record at the given offset, returns the record
+    // value and offset of the following record
+    outcome::result<std::pair<gsl::span<const uint8_t>, uint64_t>> readAt(
+        uint64_t offset) const;
+
+    MappedFile data_;
+    MappedFile index_;
+    uint64_t offset_;
+  };
+
+}  // namespace scale
+
+OUTCOME_HPP_DECLARE_ERROR_2(scale, RecordLogError)
+
+#endif  // SCALE_CORE_SCALE_RECORD_LOG_HPP
@@ -12,6 +12,7 @@
 #include <boost/throw_exception.hpp>
 #include <gsl/span>
 
+#include <scale/encoder_pool.hpp>
 #include <scale/outcome/outcome.hpp>
 #include <scale/scale_decoder_stream.hpp>
 #include <scale/scale_encoder_stream.hpp>
@@ -37,20 +38,69 @@
 
 namespace scale {
   /**
-   * @brief convenience function for encoding primitives data to stream
+   * @brief convenience function for encoding primitives data to stream,
+   * uses a stream from the pool of the calling thread, so only the result is
+   * allocated
    * @tparam Args primitive types to be encoded
    * @param args data to encode
    * @return encoded data
    */
   template <typename... Args>
   outcome::result<std::vector<uint8_t>> encode(Args &&... args) {
-    ScaleEncoderStream s{};
+    auto s = EncoderPool::acquire();
     try {
-      (s << ... << std::forward<Args>(args));
+      (*s << ... << std::forward<Args>(args));
     } catch (std::system_error &e) {
       return outcome::failure(e.code());
     }
-    return s.to_vector();
+    return s->to_vector();
+  }
+
+  /**
+   * @brief encodes data unless its size exceeds the limit, which is detected
+   * as soon as it is crossed or, for byte strings and collections of
+   * static-size elements, before they are encoded
+   * @tparam Args types of data to be encoded
+   * @param limit size limit in bytes
+   * @param args data to encode
+   * @return encoded data or EncodeError::SIZE_LIMIT_EXCEEDED
+   */
+  template <typename... Args>
+  outcome::result<std::vector<uint8_t>> encode_with_limit(size_t limit,
+                                                          Args &&... args) {
+    auto s = EncoderPool::acquire();
+    s->setSizeLimit(limit);
+    try {
+      (*s << ... << std::forward<Args>(args));
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return s->to_vector();
+  }
+
+  /**
+   * @brief encodes data into the given buffer, which content is replaced
+   * and capacity is reused, so encoding to a buffer of sufficient capacity
+   * does not allocate
+   * @tparam Args types of data to be encoded
+   * @param buffer receives encoded data
+   * @param args data to encode
+   */
+  template <typename... Args>
+  outcome::result<void> encode_into(std::vector<uint8_t> &buffer,
+                                    Args &&... args) {
+    auto s = EncoderPool::acquire();
+    buffer.clear();
+    s->swapBuffer(buffer);
+    try {
+      (*s << ... << std::forward<Args>(args));
+    } catch (std::system_error &e) {
+      s->swapBuffer(buffer);
+      buffer.clear();
+      return outcome::failure(e.code());
+    }
+    s->swapBuffer(buffer);
+    return outcome::success();
   }
 
   /**
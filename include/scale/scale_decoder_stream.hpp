@@ -6,24 +6,34 @@
 #ifndef SCALE_CORE_SCALE_SCALE_DECODER_STREAM_HPP
 #define SCALE_CORE_SCALE_SCALE_DECODER_STREAM_HPP
 
+#include <algorithm>
 #include <array>
+#include <functional>
 #include <iterator>
 #include <optional>
 
+#include <boost/container/container_fwd.hpp>
 #include <boost/variant.hpp>
 #include <gsl/span>
 
+#include <scale/detail/compact_batch.hpp>
 #include <scale/detail/fixed_width_integer.hpp>
 #include <type_traits>
 #include <utility>
 #include "scale/types.hpp"
 
 namespace scale {
+  class InternTable;
+
   class ScaleDecoderStream {
    public:
     // special tag to differentiate decoding streams from others
     static constexpr auto is_decoder_stream = true;
 
+    using ByteSpan = gsl::span<const uint8_t>;
+    using SpanIterator = ByteSpan::iterator;
+    using SizeType = ByteSpan::size_type;
+
     explicit ScaleDecoderStream(gsl::span<const uint8_t> span);
 
     /**
@@ -170,6 +180,39 @@ namespace scale {
      */
     ScaleDecoderStream &operator>>(CompactInteger &v);
 
+    /**
+     * @brief decodes compact value of native integer type
+     * @tparam T unsigned integer type
+     * @param v value to decode
+     * @return reference to stream
+     */
+    template <class T>
+    ScaleDecoderStream &operator>>(Compact<T> &v) {
+      auto size = detail::decodeCompactValue(span_.subspan(current_index_),
+                                             v.value);
+      if (not size) {
+        raise(static_cast<DecodeError>(size.error().value()));
+      }
+      nextBytes(size.value());
+      return *this;
+    }
+
+    /**
+     * @brief decodes consecutive compact values in a batch, the stream is
+     * left at the value failed to decode
+     * @tparam Out uint32_t, uint64_t or Compact of them
+     * @param out receives out.size() values
+     */
+    template <class Out>
+    void decodeCompacts(gsl::span<Out> out) {
+      auto result =
+          detail::decodeCompactBatch(span_.subspan(current_index_), out);
+      nextBytes(result.consumed);
+      if (result.error) {
+        raise(*result.error);
+      }
+    }
+
     /**
      * @brief decodes custom container with is_static_collection bool class
      * member
@@ -242,6 +285,21 @@ namespace scale {
 
       auto item_count = size.convert_to<size_type>();
 
+      if constexpr (detail::kIsBatchCompact<mutableT>
+                    or std::is_same_v<mutableT, uint8_t>) {
+        // each value takes at least a byte
+        if (not hasMore(item_count)) {
+          raise(DecodeError::NOT_ENOUGH_DATA);
+        }
+      }
+
+      if constexpr (std::is_same_v<C, std::vector<uint8_t>>) {
+        // bytes are copied at once
+        auto bytes = nextBytes(item_count);
+        v.assign(bytes.begin(), bytes.end());
+        return *this;
+      }
+
       C container;
       try {
         container.resize(item_count);
@@ -249,8 +307,13 @@ namespace scale {
         raise(DecodeError::TOO_MANY_ITEMS);
       }
 
-      for (size_type i = 0u; i < item_count; ++i) {
-        *this >> container[i];
+      if constexpr (detail::kIsBatchCompact<mutableT>
+                    and std::is_same_v<C, std::vector<mutableT>>) {
+        decodeCompacts(gsl::span<mutableT>(container));
+      } else {
+        for (size_type i = 0u; i < item_count; ++i) {
+          *this >> container[i];
+        }
       }
 
       v = std::move(container);
@@ -323,8 +386,29 @@ namespace scale {
                                        const typename T::key_type &>()])>>
         : std::true_type {};
 
+    template <typename, typename U = void>
+    struct has_key_compare : std::false_type {};
+
+    template <typename T>
+    struct has_key_compare<T, std::void_t<typename T::key_compare>>
+        : std::true_type {};
+
+    template <typename, typename U = void>
+    struct is_flat_map_like : std::false_type {};
+
+    template <typename T>
+    struct is_flat_map_like<
+        T,
+        std::void_t<typename T::sequence_type,
+                    decltype(std::declval<T &>().adopt_sequence(
+                        boost::container::ordered_unique_range,
+                        std::declval<typename T::sequence_type &&>()))>>
+        : std::true_type {};
+
     /**
-     * @brief decodes associative containers
+     * @brief decodes associative containers, keys encoded in ascending order
+     * are inserted in constant time, sorted flat containers adopt the decoded
+     * sequence as is
      * @tparam C item type
      * @param c reference to the map
      * @return reference to stream
@@ -336,14 +420,22 @@ namespace scale {
 
       auto item_count = size.convert_to<size_t>();
 
-      C container;
-      typename C::value_type pair;
-      for (size_t i = 0u; i < item_count; ++i) {
-        *this >> pair;
-        container.emplace(pair);
+      if constexpr (is_flat_map_like<C>::value) {
+        decodeFlatMap(c, item_count);
+      } else {
+        C container;
+        std::pair<typename C::key_type, typename C::mapped_type> pair;
+        auto last = container.end();
+        for (size_t i = 0u; i < item_count; ++i) {
+          *this >> pair;
+          if (strict_map_order_ and last != container.end()) {
+            checkKeyOrder(container, last->first, pair.first);
+          }
+          last = container.emplace_hint(
+              container.end(), std::move(pair.first), std::move(pair.second));
+        }
+        c = std::move(container);
       }
-
-      c = std::move(container);
       return *this;
     }
 
@@ -384,9 +476,14 @@ namespace scale {
      */
     uint8_t nextByte();
 
-    using ByteSpan = gsl::span<const uint8_t>;
-    using SpanIterator = ByteSpan::iterator;
-    using SizeType = ByteSpan::size_type;
+    /**
+     * @brief takes n bytes from stream without copying them and
+     * advances current byte iterator by n
+     * @param n number of bytes to take
+     * @return span of the underlying data
+     */
+    ByteSpan nextBytes(SizeType n);
+
 
     ByteSpan span() const {
       return span_;
@@ -395,6 +492,82 @@ namespace scale {
       return current_index_;
     }
 
+    /**
+     * Position of the stream to return to
+     */
+    struct Checkpoint {
+      SizeType index;
+    };
+
+    /**
+     * @return current position of the stream
+     */
+    Checkpoint checkpoint() const {
+      return Checkpoint{current_index_};
+    }
+
+    /**
+     * @brief returns the stream to the position of the checkpoint
+     * @param checkpoint position taken from this stream
+     */
+    void rollback(Checkpoint checkpoint);
+
+    /**
+     * @class RollbackGuard returns the stream to the position it had at
+     * construction unless committed, e.g. when decoding of one of several
+     * possible layouts throws
+     */
+    class RollbackGuard {
+     public:
+      explicit RollbackGuard(ScaleDecoderStream &stream)
+          : stream_{stream}, checkpoint_{stream.checkpoint()} {}
+
+      RollbackGuard(const RollbackGuard &) = delete;
+      RollbackGuard &operator=(const RollbackGuard &) = delete;
+
+      ~RollbackGuard() {
+        if (not committed_) {
+          stream_.rollback(checkpoint_);
+        }
+      }
+
+      /**
+       * @brief keeps the data decoded since the guard was created consumed
+       */
+      void commit() {
+        committed_ = true;
+      }
+
+     private:
+      ScaleDecoderStream &stream_;
+      Checkpoint checkpoint_;
+      bool committed_ = false;
+    };
+
+    /**
+     * @brief enables interning of values decoded as Interned<T>
+     * @param table table shared by decoded values, must outlive the stream,
+     * nullptr disables interning
+     */
+    void setInternTable(InternTable *table) {
+      intern_table_ = table;
+    }
+    InternTable *internTable() const {
+      return intern_table_;
+    }
+
+    /**
+     * @brief enables checking that map keys are encoded in strictly
+     * ascending order, as canonical encoding requires, violation is reported
+     * as DecodeError::NON_CANONICAL_ORDER
+     */
+    void setStrictMapOrder(bool strict) {
+      strict_map_order_ = strict;
+    }
+    bool strictMapOrder() const {
+      return strict_map_order_;
+    }
+
    private:
     bool decodeBool();
     /**
@@ -427,9 +600,59 @@ namespace scale {
       }
     }
 
+    // previous key must be less than the next one in strict mode, only
+    // comparable keys can be checked for maps without own ordering
+    template <class C, class K>
+    void checkKeyOrder(const C &c, const K &previous, const K &next) const {
+      bool ascending = true;
+      if constexpr (has_key_compare<C>::value) {
+        ascending = c.key_comp()(previous, next);
+      } else if constexpr (std::is_invocable_v<std::less<>,
+                                               const K &,
+                                               const K &>) {
+        ascending = std::less<>{}(previous, next);
+      }
+      if (not ascending) {
+        raise(DecodeError::NON_CANONICAL_ORDER);
+      }
+    }
+
+    template <class C>
+    void decodeFlatMap(C &c, size_t item_count) {
+      typename C::sequence_type items;
+      // each item takes at least one byte unless the map has a single item
+      items.reserve(std::min<size_t>(
+          item_count, std::max<size_t>(span_.size() - current_index_, 1)));
+      bool ordered = true;
+      auto comp = c.key_comp();
+      for (size_t i = 0u; i < item_count; ++i) {
+        items.emplace_back();
+        *this >> items.back();
+        if (i > 0 and not comp(items[i - 1].first, items[i].first)) {
+          if (strict_map_order_) {
+            raise(DecodeError::NON_CANONICAL_ORDER);
+          }
+          ordered = false;
+        }
+      }
+
+      C container;
+      if (ordered) {
+        container.adopt_sequence(boost::container::ordered_unique_range,
+                                 std::move(items));
+      } else {
+        for (auto &item : items) {
+          container.emplace(std::move(item));
+        }
+      }
+      c = std::move(container);
+    }
+
     ByteSpan span_;
     SpanIterator current_iterator_;
     SizeType current_index_;
+    InternTable *intern_table_;
+    bool strict_map_order_;
   };
 
 }  // namespace scale
@@ -6,13 +6,19 @@
 #ifndef SCALE_CORE_SCALE_SCALE_ENCODER_STREAM_HPP
 #define SCALE_CORE_SCALE_SCALE_ENCODER_STREAM_HPP
 
+#include <array>
 #include <deque>
+#include <limits>
 #include <optional>
+#include <vector>
 
 #include <boost/variant.hpp>
 #include <gsl/span>
 
+#include <scale/detail/compact_batch.hpp>
 #include <scale/detail/fixed_width_integer.hpp>
+#include <scale/encoder_sink.hpp>
+#include <scale/skip.hpp>
 
 namespace scale {
 
@@ -24,6 +30,9 @@ namespace scale {
     // special tag to differentiate encoding streams from others
     static constexpr auto is_encoder_stream = true;
 
+    // default size of the buffer of a stream writing to a sink
+    static constexpr size_t kDefaultSinkBufferSize = 4096;
+
     ScaleEncoderStream();
 
     /**
@@ -34,7 +43,21 @@ namespace scale {
     explicit ScaleEncoderStream(bool drop_data);
 
     /**
-     * @return vector of bytes containing encoded data
+     * Stream initialization
+     * @param sink - receives encoded data instead of the stream's own storage
+     * @param buffer_size - size of the buffer collecting encoded data before
+     * it is written to the sink, byte ranges of at least this size bypass the
+     * buffer, and those put by putReferencedBytes are passed to the sink by
+     * reference instead of being copied. With zero size the data
+     * is written to the sink as it is put, without allocating the buffer,
+     * except for data generated in batches.
+     */
+    explicit ScaleEncoderStream(EncoderSink &sink,
+                                size_t buffer_size = kDefaultSinkBufferSize);
+
+    /**
+     * @return vector of bytes containing encoded data, which has not been
+     * written to the sink yet
      */
     std::vector<uint8_t> to_vector() const;
 
@@ -44,6 +67,118 @@ namespace scale {
      */
     size_t size() const;
 
+    /**
+     * @brief writes buffered data to the sink, does nothing for streams
+     * without a sink
+     */
+    void flush();
+
+    /**
+     * @brief drops encoded data, which has not been written to the sink,
+     * keeping the allocated storage for reuse
+     */
+    void reset();
+
+    /**
+     * @return number of bytes the stream can hold without reallocation
+     */
+    size_t capacity() const;
+
+    /**
+     * @brief exchanges the stream's storage with the given one, which is
+     * taken as encoded data
+     * @param storage vector to exchange with
+     */
+    void swapBuffer(std::vector<uint8_t> &storage);
+
+    static constexpr size_t kNoSizeLimit = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief limits total size of encoded data. Putting data over the limit
+     * throws EncodeError::SIZE_LIMIT_EXCEEDED without putting it, byte
+     * strings and collections of static-size elements are checked as a
+     * whole before their first byte.
+     * @param limit size limit in bytes
+     */
+    void setSizeLimit(size_t limit) {
+      size_limit_ = limit;
+    }
+    size_t sizeLimit() const {
+      return size_limit_;
+    }
+
+    /**
+     * @brief checks that n more bytes fit the size limit
+     * @param n number of bytes
+     */
+    void expectSize(size_t n) const;
+
+    /**
+     * @brief puts bytes to the stream as is, without length prefix
+     * @param bytes bytes to put, which may be released after the call
+     * @return reference to stream
+     */
+    ScaleEncoderStream &putBytes(gsl::span<const uint8_t> bytes);
+
+    /**
+     * @brief puts bytes to the stream as is, without length prefix, passing
+     * ranges of at least the buffer size to the sink by reference
+     * @param bytes bytes to put, which must outlive the data of the sink
+     * @return reference to stream
+     */
+    ScaleEncoderStream &putReferencedBytes(gsl::span<const uint8_t> bytes);
+
+    /**
+     * @brief scale-encodes length of a collection, which items are put to the
+     * stream one by one afterwards, so the collection itself is never held
+     * in memory
+     * @param length number of items
+     * @return reference to stream
+     */
+    ScaleEncoderStream &encodeCollectionLength(size_t length) {
+      return *this << CompactInteger{length};
+    }
+
+    /**
+     * @brief scale-encodes collection of items from a range, which size is
+     * unknown until it is traversed, e.g. filtered or transformed one, in a
+     * single pass without materializing it
+     * @tparam It iterator type
+     * @tparam End sentinel type
+     * @param begin beginning of the range
+     * @param end end of the range
+     * @return reference to stream
+     */
+    template <class It, class End>
+    ScaleEncoderStream &encodeLazyCollection(It begin, End end) {
+      return encodeUnknownCountCollection([&](ScaleEncoderStream &s) {
+        size_t count = 0;
+        for (; begin != end; ++begin, ++count) {
+          s << *begin;
+        }
+        return count;
+      });
+    }
+
+    /**
+     * @brief scale-encodes collection of items produced by a generator
+     * @tparam Generator callable returning std::optional of an item, empty
+     * one when there are no more items
+     * @param generate generator of items
+     * @return reference to stream
+     */
+    template <class Generator>
+    ScaleEncoderStream &encodeGeneratedCollection(Generator &&generate) {
+      return encodeUnknownCountCollection([&](ScaleEncoderStream &s) {
+        size_t count = 0;
+        while (auto item = generate()) {
+          s << *item;
+          ++count;
+        }
+        return count;
+      });
+    }
+
     /**
      * @brief scale-encodes std::vector
      * @tparam T type of item
@@ -52,6 +187,13 @@ namespace scale {
      */
     template <typename T>
     ScaleEncoderStream &operator<<(const std::vector<T> &c) {
+      if constexpr (std::is_same_v<T, uint8_t>) {
+        return encodeByteCollection(c);
+      }
+      if constexpr (detail::kIsBatchCompact<T>) {
+        *this << CompactInteger{c.size()};
+        return encodeCompacts(gsl::make_span(c));
+      }
       return encodeDynamicCollection(std::size(c), std::begin(c), std::end(c));
     }
     /**
@@ -95,6 +237,12 @@ namespace scale {
      */
     template <typename T, ssize_t S>
     ScaleEncoderStream &operator<<(const gsl::span<T, S> &span) {
+      if constexpr (std::is_same_v<std::remove_const_t<T>, uint8_t>) {
+        if constexpr (S == -1) {
+          return encodeByteCollection(span);
+        }
+        return putBytes(span);
+      }
       if constexpr (S == -1) {
         return encodeDynamicCollection(
             std::size(span), std::begin(span), std::end(span));
@@ -226,6 +374,9 @@ namespace scale {
      */
     template <typename T, size_t size>
     ScaleEncoderStream &operator<<(const std::array<T, size> &a) {
+      if constexpr (std::is_same_v<T, uint8_t>) {
+        return putBytes(a);
+      }
       return encodeStaticCollection(a);
     }
 
@@ -246,7 +397,9 @@ namespace scale {
      * @return reference to stream
      */
     ScaleEncoderStream &operator<<(std::string_view sv) {
-      return encodeDynamicCollection(sv.size(), sv.begin(), sv.end());
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      auto data = reinterpret_cast<const uint8_t *>(sv.data());
+      return encodeByteCollection(gsl::make_span(data, sv.size()));
     }
 
     /**
@@ -281,6 +434,70 @@ namespace scale {
      */
     ScaleEncoderStream &operator<<(const CompactInteger &v);
 
+    /**
+     * @brief scale-encodes compact value of native integer type
+     * @tparam T unsigned integer type
+     * @param v value to encode
+     * @return reference to stream
+     */
+    template <class T>
+    ScaleEncoderStream &operator<<(const Compact<T> &v) {
+      if constexpr (detail::kIsBatchCompact<Compact<T>>) {
+        // a mode byte and up to 8 bytes of the value
+        std::array<uint8_t, 1 + sizeof(uint64_t) + detail::kCompactBatchSlack>
+            bytes{};
+        auto size =
+            detail::encodeCompactBatch(gsl::make_span(&v, 1), bytes.data());
+        return putBytes(gsl::make_span(bytes.data(), size));
+      } else {
+        return *this << CompactInteger{v.value};
+      }
+    }
+
+    /**
+     * @brief compact-encodes values one after another in a batch, sizes of
+     * all the values are computed first and they are written into the space
+     * reserved at once
+     * @tparam In uint32_t, uint64_t or Compact of them
+     * @param items values to encode
+     * @return reference to stream
+     */
+    template <class In>
+    ScaleEncoderStream &encodeCompacts(gsl::span<In> items) {
+      gsl::span<const std::remove_const_t<In>> values{items};
+      return putGenerated(
+          detail::compactBatchSize(values),
+          detail::kCompactBatchSlack,
+          [&values](uint8_t *out) { detail::encodeCompactBatch(values, out); });
+    }
+
+    /**
+     * @brief puts bytes written by generator directly to the buffer
+     * @param size number of bytes
+     * @param slack number of bytes generator may write past size
+     * @param generate writes the bytes to the given memory
+     * @return reference to stream
+     */
+    template <class F>
+    ScaleEncoderStream &putGenerated(size_t size,
+                                     size_t slack,
+                                     const F &generate) {
+      expectSize(size);
+      bytes_written_ += size;
+      if (drop_data_) {
+        return *this;
+      }
+      auto position = stream_.size();
+      stream_.resize(position + size + slack);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      generate(stream_.data() + position);
+      stream_.resize(position + size);
+      if (sink_ != nullptr and stream_.size() >= buffer_size_) {
+        flush();
+      }
+      return *this;
+    }
+
    protected:
     template <size_t I, class... Ts>
     void encodeElementOfTuple(const std::tuple<Ts...> &v) {
@@ -314,6 +531,10 @@ namespace scale {
     ScaleEncoderStream &encodeDynamicCollection(const CompactInteger &size,
                                                 It &&begin,
                                                 It &&end) {
+      using Element = std::decay_t<decltype(*begin)>;
+      if constexpr (kStaticSize<Element>.has_value()) {
+        expectCollectionSize(size, *kStaticSize<Element>);
+      }
       *this << size;
       // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
       for (auto &&it = begin; it != end; ++it) {
@@ -322,6 +543,17 @@ namespace scale {
       return *this;
     }
 
+    /**
+     * @brief scale-encodes dynamic collection of bytes at once
+     * @param bytes collection to encode
+     * @return reference to stream
+     */
+    ScaleEncoderStream &encodeByteCollection(gsl::span<const uint8_t> bytes) {
+      expectCollectionSize(bytes.size(), 1);
+      *this << CompactInteger{bytes.size()};
+      return putBytes(bytes);
+    }
+
     /**
      * @brief scale-encodes any fixed-size collection (std::array)
      * @tparam C collection type
@@ -346,9 +578,73 @@ namespace scale {
    private:
     ScaleEncoderStream &encodeOptionalBool(const std::optional<bool> &v);
 
+    /**
+     * @brief encodes collection items, which count is known only after they
+     * are encoded, and prepends them with the count. With a sink the items
+     * are held in memory until they are counted, within the size limit.
+     * @param put_items callable putting items to the given stream and
+     * returning their count
+     */
+    template <class F>
+    ScaleEncoderStream &encodeUnknownCountCollection(F &&put_items) {
+      if (sink_ != nullptr) {
+        // buffered data may be already written to the sink, so the length
+        // cannot be patched in it
+        ScaleEncoderStream items;
+        if (size_limit_ != kNoSizeLimit) {
+          // the length takes at least a byte
+          expectSize(1);
+          items.setSizeLimit(size_limit_ - bytes_written_ - 1);
+        }
+        auto count = put_items(items);
+        encodeCollectionLength(count);
+        return putBytes(items.stream_);
+      }
+      auto position = reserveCollectionLength();
+      auto count = put_items(*this);
+      return patchCollectionLength(position, count);
+    }
+
+    /**
+     * @brief reserves space for a collection length
+     * @return position of the reserved space
+     */
+    size_t reserveCollectionLength();
+
+    /**
+     * @brief puts compact length into the space reserved for it, moving the
+     * following data if the length size differs from the reserved one
+     * @param position position of the reserved space
+     * @param length collection length
+     * @return reference to stream
+     */
+    ScaleEncoderStream &patchCollectionLength(size_t position, size_t length);
+
+    /**
+     * @brief puts bytes to the stream, writing ranges of at least the buffer
+     * size to the sink directly
+     * @param bytes bytes to put
+     * @param referenced whether the sink may refer to the bytes
+     * @return reference to stream
+     */
+    ScaleEncoderStream &putRange(gsl::span<const uint8_t> bytes,
+                                 bool referenced);
+
+    /**
+     * @brief checks that a collection of static-size elements, including
+     * at least one byte of its length, fits the size limit
+     * @param size number of elements
+     * @param element_size size of an element
+     */
+    void expectCollectionSize(const CompactInteger &size,
+                              size_t element_size) const;
+
     const bool drop_data_;
-    std::deque<uint8_t> stream_;
+    std::vector<uint8_t> stream_;
     size_t bytes_written_;
+    EncoderSink *sink_;
+    size_t buffer_size_;
+    size_t size_limit_ = kNoSizeLimit;
   };
 
   /**
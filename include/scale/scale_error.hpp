@@ -19,6 +19,9 @@ namespace scale {
     COMPACT_INTEGER_TOO_BIG = 1,  ///< compact integer can't be more than 2**536
     NEGATIVE_COMPACT_INTEGER,     ///< cannot compact-encode negative integers
     DEREF_NULLPOINTER,            ///< dereferencing a null pointer
+    SIZE_LIMIT_EXCEEDED,          ///< encoded data exceeds the size limit
+    COLUMN_SIZE_MISMATCH,         ///< columns of a vector differ in size
+    UNEXPECTED_ENCODING,          ///< encoded data differs from the expected
   };
 
   /**
@@ -29,7 +32,10 @@ namespace scale {
     UNEXPECTED_VALUE,       ///< unexpected value
     TOO_MANY_ITEMS,         ///< too many items, cannot address them in memory
     WRONG_TYPE_INDEX,       ///< wrong type index, cannot decode variant
-    INVALID_ENUM_VALUE      ///< enum value which doesn't belong to the enum
+    INVALID_ENUM_VALUE,     ///< enum value which doesn't belong to the enum
+    NON_CANONICAL_ORDER,    ///< map keys are not in strictly ascending order
+    VALUE_OUT_OF_RANGE,     ///< compact value does not fit the target type
+    TOO_DEEP_NESTING        ///< values are nested deeper than allowed
   };
 
 }  // namespace scale
@@ -0,0 +1,69 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_SCATTER_GATHER_SINK_HPP
+#define SCALE_CORE_SCALE_SCATTER_GATHER_SINK_HPP
+
+#include <sys/uio.h>
+
+#include <vector>
+
+#include <scale/encoder_sink.hpp>
+
+namespace scale {
+
+  /**
+   * @class ScatterGatherSink collects encoded data as a list of byte ranges
+   * suitable for writev/sendmsg. Written data is copied to the sink's own
+   * storage, while ranges put by putReferencedBytes are pointed to in place,
+   * so their owners must outlive the produced list.
+   * @code{.cpp}
+   * ScatterGatherSink sink;
+   * ScaleEncoderStream s{sink, 256};  // byte ranges from 256 bytes are referenced
+   * s << header << CompactInteger{body.size()};
+   * s.putReferencedBytes(body);
+   * s.flush();
+   * auto iov = sink.iovecs();
+   * writev(fd, iov.data(), iov.size());
+   * @endcode
+   */
+  class ScatterGatherSink final : public EncoderSink {
+   public:
+    void write(gsl::span<const uint8_t> bytes) override;
+
+    void reference(gsl::span<const uint8_t> bytes) override;
+
+    /**
+     * @return list of byte ranges making up the encoded data, valid until the
+     * sink is modified
+     */
+    std::vector<iovec> iovecs() const;
+
+    /**
+     * @return total size of the collected data in bytes
+     */
+    size_t size() const;
+
+    /**
+     * @brief drops the collected data, keeping the allocated storage
+     */
+    void clear();
+
+   private:
+    struct Segment {
+      // nullptr when the segment resides in own storage
+      const uint8_t *external;
+      size_t offset;
+      size_t size;
+    };
+
+    std::vector<uint8_t> storage_;
+    std::vector<Segment> segments_;
+    size_t size_ = 0;
+  };
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_SCATTER_GATHER_SINK_HPP
@@ -0,0 +1,232 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_SKIP_HPP
+#define SCALE_CORE_SCALE_SKIP_HPP
+
+#include <array>
+#include <deque>
+#include <limits>
+#include <list>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/variant.hpp>
+
+#include <scale/outcome/outcome_throw.hpp>
+#include <scale/scale_decoder_stream.hpp>
+#include <scale/scale_error.hpp>
+#include <scale/tie.hpp>
+
+namespace scale {
+
+  namespace detail {
+    template <class T>
+    struct is_std_array : std::false_type {};
+
+    template <class T, size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    // collections encoded as compact length and elements
+    template <class T>
+    struct is_sequence : std::false_type {};
+
+    template <class T>
+    struct is_sequence<std::vector<T>> : std::true_type {};
+
+    template <class T>
+    struct is_sequence<std::deque<T>> : std::true_type {};
+
+    template <class T>
+    struct is_sequence<std::list<T>> : std::true_type {};
+
+    template <>
+    struct is_sequence<std::string> : std::true_type {};
+
+    template <class T>
+    struct is_compact : std::false_type {};
+
+    template <class T>
+    struct is_compact<Compact<T>> : std::true_type {};
+
+    template <class T>
+    struct is_optional : std::false_type {};
+
+    template <class T>
+    struct is_optional<std::optional<T>> : std::true_type {};
+
+    template <class T>
+    struct is_variant : std::false_type {};
+
+    template <class... Ts>
+    struct is_variant<boost::variant<Ts...>> : std::true_type {};
+
+    template <class T>
+    constexpr std::optional<size_t> staticSize();
+
+    template <class Tuple, size_t... I>
+    constexpr std::optional<size_t> staticSizeOfFields(
+        std::index_sequence<I...> /*unused*/) {
+      constexpr std::array<std::optional<size_t>, sizeof...(I)> sizes{
+          staticSize<std::tuple_element_t<I, Tuple>>()...};
+      size_t total = 0;
+      for (const auto &size : sizes) {
+        if (not size) {
+          return std::nullopt;
+        }
+        total += *size;
+      }
+      return total;
+    }
+
+    template <class T>
+    constexpr std::optional<size_t> staticSize() {
+      if constexpr (std::is_integral_v<T>) {
+        return sizeof(T);
+      } else if constexpr (std::is_enum_v<T>) {
+        return sizeof(std::underlying_type_t<T>);
+      } else if constexpr (is_std_array<T>::value) {
+        constexpr auto element = staticSize<typename T::value_type>();
+        if constexpr (element.has_value()) {
+          return *element * std::tuple_size_v<T>;
+        } else {
+          return std::nullopt;
+        }
+      } else if constexpr (has_fields<T>::value) {
+        using Fields = typename FieldTypes<T>::type;
+        return staticSizeOfFields<Fields>(
+            std::make_index_sequence<std::tuple_size_v<Fields>>{});
+      } else {
+        return std::nullopt;
+      }
+    }
+  }  // namespace detail
+
+  /**
+   * Size of encoded value of the type if it does not depend on the value,
+   * std::nullopt otherwise
+   */
+  template <class T>
+  constexpr std::optional<size_t> kStaticSize =
+      detail::staticSize<std::decay_t<T>>();
+
+  template <class T>
+  void skip(ScaleDecoderStream &s);
+
+  namespace detail {
+    /**
+     * @brief decodes compact length of a collection
+     */
+    inline size_t decodeLength(ScaleDecoderStream &s) {
+      CompactInteger length;
+      s >> length;
+      if (length > std::numeric_limits<uint32_t>::max()) {
+        raise(DecodeError::TOO_MANY_ITEMS);
+      }
+      return length.convert_to<size_t>();
+    }
+
+    inline void skipCompact(ScaleDecoderStream &s) {
+      auto first = s.nextByte();
+      switch (first & 0b11u) {
+        case 0b00u:
+          return;
+        case 0b01u:
+          s.nextBytes(1);
+          return;
+        case 0b10u:
+          s.nextBytes(3);
+          return;
+        default:
+          s.nextBytes((first >> 2u) + 4);
+      }
+    }
+
+    template <class T>
+    void skipElements(ScaleDecoderStream &s, size_t count) {
+      if constexpr (kStaticSize<T>.has_value()) {
+        constexpr auto size = *kStaticSize<T>;
+        if constexpr (size != 0) {
+          if (count > std::numeric_limits<uint32_t>::max() / size) {
+            raise(DecodeError::NOT_ENOUGH_DATA);
+          }
+        }
+        s.nextBytes(count * size);
+      } else {
+        for (size_t i = 0; i < count; ++i) {
+          skip<T>(s);
+        }
+      }
+    }
+
+    template <class Tuple, size_t... I>
+    void skipFields(ScaleDecoderStream &s,
+                    std::index_sequence<I...> /*unused*/) {
+      (skip<std::tuple_element_t<I, Tuple>>(s), ...);
+    }
+
+    template <class... Ts>
+    void skipAlternative(ScaleDecoderStream &s, size_t index) {
+      using Skip = void (*)(ScaleDecoderStream &);
+      static constexpr std::array<Skip, sizeof...(Ts)> kSkips{&skip<Ts>...};
+      kSkips.at(index)(s);
+    }
+
+    template <class... Ts>
+    void skipVariant(ScaleDecoderStream &s,
+                     const boost::variant<Ts...> * /*unused*/) {
+      auto index = s.nextByte();
+      if (index >= sizeof...(Ts)) {
+        raise(DecodeError::WRONG_TYPE_INDEX);
+      }
+      skipAlternative<Ts...>(s, index);
+    }
+  }  // namespace detail
+
+  /**
+   * @brief moves the stream past an encoded value of type T without
+   * decoding it. Values of static size are skipped in constant time, byte
+   * strings without looking at their content, types with custom codecs are
+   * decoded into a temporary. Values are not validated.
+   * @tparam T type of the encoded value
+   * @param s stream positioned at the value
+   */
+  template <class T>
+  void skip(ScaleDecoderStream &s) {
+    using V = std::decay_t<T>;
+    if constexpr (kStaticSize<V>.has_value()) {
+      s.nextBytes(*kStaticSize<V>);
+    } else if constexpr (std::is_same_v<V, CompactInteger>
+                         or detail::is_compact<V>::value) {
+      detail::skipCompact(s);
+    } else if constexpr (std::is_same_v<V, std::vector<bool>>) {
+      s.nextBytes(detail::decodeLength(s));
+    } else if constexpr (detail::is_sequence<V>::value
+                         or ScaleDecoderStream::is_map_like<V>::value) {
+      detail::skipElements<typename V::value_type>(s, detail::decodeLength(s));
+    } else if constexpr (detail::is_std_array<V>::value) {
+      detail::skipElements<typename V::value_type>(s, std::tuple_size_v<V>);
+    } else if constexpr (detail::is_optional<V>::value) {
+      // optional bool is a single byte
+      if (s.nextByte() != 0
+          and not std::is_same_v<typename V::value_type, bool>) {
+        skip<typename V::value_type>(s);
+      }
+    } else if constexpr (detail::is_variant<V>::value) {
+      detail::skipVariant(s, static_cast<const V *>(nullptr));
+    } else if constexpr (detail::has_fields<V>::value) {
+      using Fields = typename detail::FieldTypes<V>::type;
+      detail::skipFields<Fields>(
+          s, std::make_index_sequence<std::tuple_size_v<Fields>>{});
+    } else {
+      V value{};
+      s >> value;
+    }
+  }
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_SKIP_HPP
@@ -0,0 +1,61 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_STREAM_SINKS_HPP
+#define SCALE_CORE_SCALE_STREAM_SINKS_HPP
+
+#include <ostream>
+
+#include <scale/encoder_sink.hpp>
+
+namespace scale {
+
+  /**
+   * Buffer size of ScaleEncoderStream suitable for streaming to files, peak
+   * memory of encoding is bounded by it regardless of the output size
+   * @code{.cpp}
+   * FileDescriptorSink sink{fd};
+   * ScaleEncoderStream s{sink, kStreamingBufferSize};
+   * s.encodeCollectionLength(accounts_count);
+   * for (auto &&account : accounts) {
+   *   s << account;
+   * }
+   * s.flush();
+   * @endcode
+   */
+  constexpr size_t kStreamingBufferSize = 1u << 20u;
+
+  /**
+   * @class FileDescriptorSink writes encoded data to a file descriptor,
+   * which is not owned by the sink. Write errors, including writes of no
+   * data, are thrown as std::system_error.
+   */
+  class FileDescriptorSink final : public EncoderSink {
+   public:
+    explicit FileDescriptorSink(int fd) : fd_{fd} {}
+
+    void write(gsl::span<const uint8_t> bytes) override;
+
+   private:
+    int fd_;
+  };
+
+  /**
+   * @class OstreamSink writes encoded data to std::ostream. Stream failure is
+   * thrown as std::system_error with std::io_errc::stream code.
+   */
+  class OstreamSink final : public EncoderSink {
+   public:
+    explicit OstreamSink(std::ostream &out) : out_{out} {}
+
+    void write(gsl::span<const uint8_t> bytes) override;
+
+   private:
+    std::ostream &out_;
+  };
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_STREAM_SINKS_HPP
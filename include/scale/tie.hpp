@@ -0,0 +1,127 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_TIE_HPP
+#define SCALE_CORE_SCALE_TIE_HPP
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#define SCALE_TIE_FIELDS_1 v1
+#define SCALE_TIE_FIELDS_2 SCALE_TIE_FIELDS_1, v2
+#define SCALE_TIE_FIELDS_3 SCALE_TIE_FIELDS_2, v3
+#define SCALE_TIE_FIELDS_4 SCALE_TIE_FIELDS_3, v4
+#define SCALE_TIE_FIELDS_5 SCALE_TIE_FIELDS_4, v5
+#define SCALE_TIE_FIELDS_6 SCALE_TIE_FIELDS_5, v6
+#define SCALE_TIE_FIELDS_7 SCALE_TIE_FIELDS_6, v7
+#define SCALE_TIE_FIELDS_8 SCALE_TIE_FIELDS_7, v8
+#define SCALE_TIE_FIELDS_9 SCALE_TIE_FIELDS_8, v9
+#define SCALE_TIE_FIELDS_10 SCALE_TIE_FIELDS_9, v10
+#define SCALE_TIE_FIELDS_11 SCALE_TIE_FIELDS_10, v11
+#define SCALE_TIE_FIELDS_12 SCALE_TIE_FIELDS_11, v12
+#define SCALE_TIE_FIELDS_13 SCALE_TIE_FIELDS_12, v13
+#define SCALE_TIE_FIELDS_14 SCALE_TIE_FIELDS_13, v14
+#define SCALE_TIE_FIELDS_15 SCALE_TIE_FIELDS_14, v15
+#define SCALE_TIE_FIELDS_16 SCALE_TIE_FIELDS_15, v16
+
+/**
+ * Describes fields of a struct for SCALE, so that it is encoded and decoded
+ * as a tuple of its fields in declaration order and its field types are
+ * known to field extraction and skipping
+ * @code{.cpp}
+ * struct Header {
+ *   SCALE_TIE(3);
+ *   Hash parent;
+ *   uint32_t number;
+ *   Digest digest;
+ * };
+ * @endcode
+ * @param N number of non-static data members, up to 16
+ */
+#define SCALE_TIE(N)                                \
+  static constexpr size_t scale_tie_size = N;       \
+  auto as_tie() {                                   \
+    auto &[SCALE_TIE_FIELDS_##N] = *this;           \
+    return std::tie(SCALE_TIE_FIELDS_##N);          \
+  }                                                 \
+  auto as_tie() const {                             \
+    const auto &[SCALE_TIE_FIELDS_##N] = *this;     \
+    return std::tie(SCALE_TIE_FIELDS_##N);          \
+  }
+
+namespace scale {
+
+  template <typename, typename U = void>
+  struct is_tied : std::false_type {};
+
+  template <typename T>
+  struct is_tied<T, std::void_t<decltype(T::scale_tie_size)>>
+      : std::true_type {};
+
+  template <typename T>
+  constexpr bool is_tied_v = is_tied<T>::value;
+
+  namespace detail {
+    template <class T, typename = void>
+    struct FieldTypes;
+
+    template <class F, class S>
+    struct FieldTypes<std::pair<F, S>> {
+      using type = std::tuple<std::remove_const_t<F>, std::remove_const_t<S>>;
+    };
+
+    template <class... Ts>
+    struct FieldTypes<std::tuple<Ts...>> {
+      using type = std::tuple<std::remove_const_t<Ts>...>;
+    };
+
+    template <class... Ts>
+    struct FieldTypes<std::tuple<Ts &...>> {
+      using type = std::tuple<std::remove_const_t<Ts>...>;
+    };
+
+    template <class T>
+    struct FieldTypes<T, std::enable_if_t<is_tied_v<T>>>
+        : FieldTypes<decltype(std::declval<T &>().as_tie())> {};
+
+    template <class T, typename = void>
+    struct has_fields : std::false_type {};
+
+    template <class T>
+    struct has_fields<T, std::void_t<typename FieldTypes<T>::type>>
+        : std::true_type {};
+  }  // namespace detail
+
+  /// types of fields of a pair, tuple or tied struct as a std::tuple
+  template <class T>
+  using field_types_t = typename detail::FieldTypes<std::decay_t<T>>::type;
+
+  /**
+   * @brief scale-encodes struct described with SCALE_TIE as its fields
+   */
+  template <class Stream,
+            class T,
+            typename = std::enable_if_t<Stream::is_encoder_stream>,
+            typename = std::enable_if_t<is_tied_v<T>>>
+  Stream &operator<<(Stream &s, const T &v) {
+    return s << v.as_tie();
+  }
+
+  /**
+   * @brief scale-decodes struct described with SCALE_TIE field by field
+   */
+  template <class Stream,
+            class T,
+            typename = std::enable_if_t<Stream::is_decoder_stream>,
+            typename = std::enable_if_t<is_tied_v<T>>>
+  Stream &operator>>(Stream &s, T &v) {
+    auto fields = v.as_tie();
+    return s >> fields;
+  }
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_TIE_HPP
@@ -6,6 +6,7 @@
 #ifndef SCALE_SCALE_TYPES_HPP
 #define SCALE_SCALE_TYPES_HPP
 
+#include <type_traits>
 #include <vector>
 
 #include <boost/multiprecision/cpp_int.hpp>
@@ -21,6 +22,27 @@ namespace scale {
    */
   using CompactInteger = boost::multiprecision::cpp_int;
 
+  /**
+   * @brief unsigned integer encoded in compact form, decoded with its range
+   * checked. Vectors of Compact<uint32_t> and Compact<uint64_t> are decoded
+   * in batches.
+   * @tparam T unsigned integer type
+   */
+  template <class T>
+  struct Compact {
+    static_assert(std::is_unsigned_v<T> and not std::is_same_v<T, bool>,
+                  "compact values are unsigned integers");
+
+    T value{};
+
+    bool operator==(const Compact &other) const {
+      return value == other.value;
+    }
+    bool operator!=(const Compact &other) const {
+      return value != other.value;
+    }
+  };
+
   /**
    * @brief OptionalBool is internal extended bool type
    */
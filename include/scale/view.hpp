@@ -0,0 +1,178 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_VIEW_HPP
+#define SCALE_CORE_SCALE_VIEW_HPP
+
+#include <array>
+
+#include <gsl/span>
+
+#include <scale/outcome/outcome.hpp>
+#include <scale/skip.hpp>
+
+namespace scale {
+
+  namespace detail {
+    template <size_t N>
+    struct FieldOffsets {
+      std::array<size_t, N + 1> offsets;
+      // number of leading offsets, which are known
+      size_t known;
+    };
+
+    /**
+     * @return offsets of fields, which are preceded only by fields of
+     * static size, and offset of the end if all the fields are such
+     */
+    template <class Fields, size_t... I>
+    constexpr FieldOffsets<sizeof...(I)> staticFieldOffsets(
+        std::index_sequence<I...> /*unused*/) {
+      constexpr std::array<std::optional<size_t>, sizeof...(I)> sizes{
+          kStaticSize<std::tuple_element_t<I, Fields>>...};
+      FieldOffsets<sizeof...(I)> result{{}, 1};
+      for (size_t i = 0; i < sizes.size() and sizes[i].has_value(); ++i) {
+        result.offsets[i + 1] = result.offsets[i] + *sizes[i];
+        ++result.known;
+      }
+      return result;
+    }
+  }  // namespace detail
+
+  /**
+   * @class View reads fields of an encoded pair, tuple or struct described
+   * with SCALE_TIE without decoding the whole value. Fields preceded only
+   * by fields of static size are read at constant offsets, others are found
+   * by skipping the fields before them on the first access, and their
+   * offsets are kept in the view. The view neither owns nor validates the
+   * encoded value, and it is not safe for concurrent use.
+   * @code{.cpp}
+   * View<Header> header{encoded};
+   * OUTCOME_TRY(number, header.get<1>());
+   * OUTCOME_TRY(digest, header.view<3>());
+   * @endcode
+   * @tparam T type of the encoded value
+   */
+  template <class T>
+  class View {
+    using Fields = field_types_t<T>;
+
+   public:
+    static constexpr size_t kFields = std::tuple_size_v<Fields>;
+
+    template <size_t I>
+    using field_t = std::tuple_element_t<I, Fields>;
+
+    /**
+     * @param encoded encoded value, which must outlive the view
+     */
+    explicit View(gsl::span<const uint8_t> encoded)
+        : encoded_{encoded},
+          offsets_{kStaticOffsets.offsets},
+          located_{kStaticOffsets.known} {}
+
+    gsl::span<const uint8_t> encoded() const {
+      return encoded_;
+    }
+
+    /**
+     * @brief decodes the field
+     * @tparam I index of the field
+     * @return decoded field or error
+     */
+    template <size_t I>
+    outcome::result<field_t<I>> get() const {
+      OUTCOME_TRY(offset, offsetOf<I>());
+      ScaleDecoderStream s{encoded_.subspan(offset)};
+      field_t<I> value{};
+      try {
+        s >> value;
+      } catch (std::system_error &e) {
+        return outcome::failure(e.code());
+      }
+      return value;
+    }
+
+    /**
+     * @tparam I index of the field
+     * @return encoded field within encoded value or error
+     */
+    template <size_t I>
+    outcome::result<gsl::span<const uint8_t>> bytes() const {
+      OUTCOME_TRY(begin, offsetOf<I>());
+      OUTCOME_TRY(end, offsetOf<I + 1>());
+      return encoded_.subspan(begin, end - begin);
+    }
+
+    /**
+     * @tparam I index of the field, which is a pair, tuple or tied struct
+     * @return view of the field or error
+     */
+    template <size_t I>
+    outcome::result<View<field_t<I>>> view() const {
+      OUTCOME_TRY(field, bytes<I>());
+      return View<field_t<I>>{field};
+    }
+
+    /**
+     * @return size of the encoded value, as it may be followed by other data
+     */
+    outcome::result<size_t> size() const {
+      return offsetOf<kFields>();
+    }
+
+   private:
+    using Skip = void (*)(ScaleDecoderStream &);
+
+    template <size_t... I>
+    static constexpr std::array<Skip, kFields> skips(
+        std::index_sequence<I...> /*unused*/) {
+      return {&skip<field_t<I>>...};
+    }
+
+    static constexpr auto kStaticOffsets = detail::staticFieldOffsets<Fields>(
+        std::make_index_sequence<kFields>{});
+    static constexpr auto kSkips = skips(std::make_index_sequence<kFields>{});
+
+    template <size_t I>
+    outcome::result<size_t> offsetOf() const {
+      static_assert(I <= kFields, "field index is out of range");
+      if constexpr (I < kStaticOffsets.known) {
+        constexpr auto offset = kStaticOffsets.offsets[I];
+        if (offset > static_cast<size_t>(encoded_.size())) {
+          return DecodeError::NOT_ENOUGH_DATA;
+        }
+        return offset;
+      } else {
+        return locate(I);
+      }
+    }
+
+    // skips fields from the last located one up to the index
+    outcome::result<size_t> locate(size_t index) const {
+      auto base = offsets_[located_ - 1];
+      if (base > static_cast<size_t>(encoded_.size())) {
+        return DecodeError::NOT_ENOUGH_DATA;
+      }
+      ScaleDecoderStream s{encoded_.subspan(base)};
+      try {
+        for (; located_ <= index; ++located_) {
+          kSkips[located_ - 1](s);
+          offsets_[located_] = base + s.currentIndex();
+        }
+      } catch (std::system_error &e) {
+        return outcome::failure(e.code());
+      }
+      return offsets_[index];
+    }
+
+    gsl::span<const uint8_t> encoded_;
+    mutable std::array<size_t, kFields + 1> offsets_;
+    mutable size_t located_;
+  };
+
+}  // namespace scale
+
+#endif  // SCALE_CORE_SCALE_VIEW_HPP
@@ -0,0 +1,294 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/detail/compact_batch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace scale::detail {
+
+  namespace {
+    template <class Out>
+    bool decodeOne(gsl::span<const uint8_t> bytes,
+                   Out &out,
+                   CompactBatchResult &result) {
+      compact_value_t<Out> value{};
+      auto size = decodeCompactValue(bytes.subspan(result.consumed), value);
+      if (not size) {
+        result.error = static_cast<DecodeError>(size.error().value());
+        return false;
+      }
+      out = Out{value};
+      result.consumed += size.value();
+      ++result.decoded;
+      return true;
+    }
+
+#if defined(__SSE2__)
+    // values of a block are stored as lanes of Lane type and widened
+    // size of an SSE2 register in bytes
+    constexpr size_t kBlockSize = 16;
+
+    template <class Lane, class Out>
+    void storeBlock(__m128i values, Out *out) {
+      std::array<Lane, kBlockSize / sizeof(Lane)> lanes{};
+      _mm_storeu_si128(
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+          reinterpret_cast<__m128i *>(lanes.data()),
+          values);
+      for (size_t i = 0; i < lanes.size(); ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out[i] = Out{lanes[i]};
+      }
+    }
+
+    /**
+     * Decodes 16 bytes holding 16 single-byte, 8 two-byte or 4 four-byte
+     * values, if all the values of the block have the same mode
+     * @return number of decoded values, 0 for blocks of mixed modes
+     */
+    template <class Out>
+    size_t decodeBlock(const uint8_t *bytes, Out *out, size_t capacity) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes));
+      constexpr int kAllLanes = 0xffff;
+      if (capacity >= 16) {
+        auto modes = _mm_and_si128(block, _mm_set1_epi8(0b11));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(modes, _mm_setzero_si128()))
+            == kAllLanes) {
+          // shifting 16-bit lanes moves bits across bytes, they are masked
+          auto values =
+              _mm_and_si128(_mm_srli_epi16(block, 2), _mm_set1_epi8(0x3f));
+          storeBlock<uint8_t>(values, out);
+          return 16;
+        }
+      }
+      if (capacity >= 8) {
+        auto modes = _mm_and_si128(block, _mm_set1_epi16(0b11));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(modes, _mm_set1_epi16(0b01)))
+            == kAllLanes) {
+          storeBlock<uint16_t>(_mm_srli_epi16(block, 2), out);
+          return 8;
+        }
+      }
+      if (capacity >= 4) {
+        auto modes = _mm_and_si128(block, _mm_set1_epi32(0b11));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(modes, _mm_set1_epi32(0b10)))
+            == kAllLanes) {
+          storeBlock<uint32_t>(_mm_srli_epi32(block, 2), out);
+          return 4;
+        }
+      }
+      return 0;
+    }
+#endif
+
+    template <class T>
+    T valueOf(const T &value) {
+      return value;
+    }
+
+    template <class T>
+    T valueOf(const Compact<T> &value) {
+      return value.value;
+    }
+
+    size_t significantBytes(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+      return (64 - __builtin_clzll(value | 1u) + 7) / 8;
+#else
+      size_t bytes = 1;
+      while ((value >>= 8u) != 0) {
+        ++bytes;
+      }
+      return bytes;
+#endif
+    }
+
+    size_t compactSize(uint64_t value) {
+      if (value < compact::EncodingCategoryLimits::kMinUint16) {
+        return 1;
+      }
+      if (value < compact::EncodingCategoryLimits::kMinUint32) {
+        return 2;
+      }
+      if (value < compact::EncodingCategoryLimits::kMinBigInteger) {
+        return 4;
+      }
+      return 1 + std::max<size_t>(significantBytes(value), 4);
+    }
+
+    void storeLittle(uint8_t *out, uint64_t value) {
+      for (size_t i = 0; i < sizeof(value); ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+      }
+    }
+  }  // namespace
+
+  template <class In>
+  size_t compactBatchSize(gsl::span<const In> values) {
+    size_t size = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    if constexpr (std::is_same_v<compact_value_t<In>, uint32_t>) {
+      // unsigned comparison as signed one of values with flipped sign bits
+      const auto sign = _mm_set1_epi32(INT32_MIN);
+      const auto threshold = [&sign](uint32_t limit) {
+        return _mm_xor_si128(_mm_set1_epi32(static_cast<int>(limit - 1)),
+                             sign);
+      };
+      const auto min_uint16 =
+          threshold(compact::EncodingCategoryLimits::kMinUint16);
+      const auto min_uint32 =
+          threshold(compact::EncodingCategoryLimits::kMinUint32);
+      const auto min_big =
+          threshold(compact::EncodingCategoryLimits::kMinBigInteger);
+      // sizes are 1 plus 1, 2 and 1 more over each limit, masks are -1
+      auto sizes = _mm_setzero_si128();
+      for (; i + 4 <= static_cast<size_t>(values.size()); i += 4) {
+        std::array<uint32_t, 4> lanes{valueOf(values[i]),
+                                      valueOf(values[i + 1]),
+                                      valueOf(values[i + 2]),
+                                      valueOf(values[i + 3])};
+        auto block = _mm_xor_si128(
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes.data())),
+            sign);
+        auto over_uint16 = _mm_cmpgt_epi32(block, min_uint16);
+        auto over_uint32 = _mm_cmpgt_epi32(block, min_uint32);
+        auto over_big = _mm_cmpgt_epi32(block, min_big);
+        sizes = _mm_sub_epi32(sizes, over_uint16);
+        sizes = _mm_sub_epi32(sizes, _mm_add_epi32(over_uint32, over_uint32));
+        sizes = _mm_sub_epi32(sizes, over_big);
+      }
+      std::array<uint32_t, 4> totals{};
+      _mm_storeu_si128(
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+          reinterpret_cast<__m128i *>(totals.data()),
+          sizes);
+      // each lane grows by at most 4 per 4 values, so it does not overflow
+      // for collections of 32-bit length
+      size = i + totals[0] + totals[1] + totals[2] + totals[3];
+    }
+#endif
+    for (; i < static_cast<size_t>(values.size()); ++i) {
+      size += compactSize(valueOf(values[i]));
+    }
+    return size;
+  }
+
+  template <class In>
+  size_t encodeCompactBatch(gsl::span<const In> values, uint8_t *out) {
+    auto *begin = out;
+    for (const auto &item : values) {
+      uint64_t value = valueOf(item);
+      // modes of up to 4 bytes store the value shifted by 2 bits with the
+      // mode in the lower bits, writing whole 8 bytes
+      if (value < compact::EncodingCategoryLimits::kMinUint16) {
+        storeLittle(out, value << 2u);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out += 1;
+      } else if (value < compact::EncodingCategoryLimits::kMinUint32) {
+        storeLittle(out, (value << 2u) | 0b01u);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out += 2;
+      } else if (value < compact::EncodingCategoryLimits::kMinBigInteger) {
+        storeLittle(out, (value << 2u) | 0b10u);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out += 4;
+      } else {
+        auto bytes = std::max<size_t>(significantBytes(value), 4);
+        *out = static_cast<uint8_t>(((bytes - 4) << 2u) | 0b11u);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        storeLittle(out + 1, value);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out += 1 + bytes;
+      }
+    }
+    return out - begin;
+  }
+
+  template <class Out>
+  CompactBatchResult decodeCompactBatchScalar(gsl::span<const uint8_t> bytes,
+                                              gsl::span<Out> out) {
+    CompactBatchResult result{0, 0, std::nullopt};
+    for (auto &value : out) {
+      if (not decodeOne(bytes, value, result)) {
+        break;
+      }
+    }
+    return result;
+  }
+
+  template <class Out>
+  CompactBatchResult decodeCompactBatch(gsl::span<const uint8_t> bytes,
+                                        gsl::span<Out> out) {
+#if defined(__SSE2__)
+    CompactBatchResult result{0, 0, std::nullopt};
+    auto count = static_cast<size_t>(out.size());
+    auto size = static_cast<size_t>(bytes.size());
+    while (result.decoded < count) {
+      if (result.consumed + kBlockSize <= size) {
+        auto decoded = decodeBlock(
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            bytes.data() + result.consumed,
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            out.data() + result.decoded,
+            count - result.decoded);
+        if (decoded != 0) {
+          result.decoded += decoded;
+          result.consumed += kBlockSize;
+          continue;
+        }
+      }
+      if (not decodeOne(bytes, out[result.decoded], result)) {
+        break;
+      }
+    }
+    return result;
+#else
+    return decodeCompactBatchScalar(bytes, out);
+#endif
+  }
+
+  template CompactBatchResult decodeCompactBatch(gsl::span<const uint8_t>,
+                                                 gsl::span<uint32_t>);
+  template CompactBatchResult decodeCompactBatch(gsl::span<const uint8_t>,
+                                                 gsl::span<uint64_t>);
+  template CompactBatchResult decodeCompactBatch(
+      gsl::span<const uint8_t>, gsl::span<Compact<uint32_t>>);
+  template CompactBatchResult decodeCompactBatch(
+      gsl::span<const uint8_t>, gsl::span<Compact<uint64_t>>);
+
+  template CompactBatchResult decodeCompactBatchScalar(
+      gsl::span<const uint8_t>, gsl::span<uint32_t>);
+  template CompactBatchResult decodeCompactBatchScalar(
+      gsl::span<const uint8_t>, gsl::span<uint64_t>);
+  template CompactBatchResult decodeCompactBatchScalar(
+      gsl::span<const uint8_t>, gsl::span<Compact<uint32_t>>);
+  template CompactBatchResult decodeCompactBatchScalar(
+      gsl::span<const uint8_t>, gsl::span<Compact<uint64_t>>);
+
+
+  template size_t compactBatchSize(gsl::span<const uint32_t>);
+  template size_t compactBatchSize(gsl::span<const uint64_t>);
+  template size_t compactBatchSize(gsl::span<const Compact<uint32_t>>);
+  template size_t compactBatchSize(gsl::span<const Compact<uint64_t>>);
+
+  template size_t encodeCompactBatch(gsl::span<const uint32_t>, uint8_t *);
+  template size_t encodeCompactBatch(gsl::span<const uint64_t>, uint8_t *);
+  template size_t encodeCompactBatch(gsl::span<const Compact<uint32_t>>,
+                                     uint8_t *);
+  template size_t encodeCompactBatch(gsl::span<const Compact<uint64_t>>,
+                                     uint8_t *);
+
+}  // namespace scale::detail
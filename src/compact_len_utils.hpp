@@ -30,6 +30,46 @@ namespace scale::compact {
     if (val < EncodingCategoryLimits::kMinBigInteger) return 4;
     return countBytes(val);
   }
+
+  // max size of compact-encoded 64-bit value
+  constexpr size_t kMaxCompactLengthSize = 9;
+
+  /**
+   * @brief compact-encodes native integer without CompactInteger
+   * @param value value to encode
+   * @param out buffer of at least kMaxCompactLengthSize bytes
+   * @return number of bytes written
+   */
+  inline size_t encodeCompactLength(uint64_t value, uint8_t *out) {
+    auto put = [&out](uint64_t v, size_t size) {
+      for (size_t i = 0; i < size; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out[i] = static_cast<uint8_t>(v >> (8 * i));
+      }
+    };
+    if (value < EncodingCategoryLimits::kMinUint16) {
+      put(value << 2u, 1);
+      return 1;
+    }
+    if (value < EncodingCategoryLimits::kMinUint32) {
+      put((value << 2u) | 0b01u, 2);
+      return 2;
+    }
+    if (value < EncodingCategoryLimits::kMinBigInteger) {
+      put((value << 2u) | 0b10u, 4);
+      return 4;
+    }
+    size_t bytes = 4;
+    while (bytes < 8 and (value >> (8 * bytes)) != 0) {
+      ++bytes;
+    }
+    // the header holds number of the value bytes following it
+    put(((bytes - 4) << 2u) | 0b11u, 1);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    out += 1;
+    put(value, bytes);
+    return bytes + 1;
+  }
 }  // namespace scale::compact
 
 #endif  // SCALE_CORE_SCALE_COMPACT_LEN_UTILS_HPP
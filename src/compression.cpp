@@ -0,0 +1,136 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/compression.hpp"
+
+#include <scale/outcome/outcome_throw.hpp>
+
+OUTCOME_CPP_DEFINE_CATEGORY_3(scale, CompressionError, e) {
+  using scale::CompressionError;
+  switch (e) {
+    case CompressionError::UNKNOWN_CODEC:
+      return "SCALE compression: unknown codec id in the frame header";
+    case CompressionError::CORRUPTED_DATA:
+      return "SCALE compression: compressed data is malformed or truncated";
+    case CompressionError::SIZE_MISMATCH:
+      return "SCALE compression: data does not match the declared size";
+    case CompressionError::TOO_LARGE:
+      return "SCALE compression: uncompressed size exceeds the limit";
+    case CompressionError::COMPRESSION_FAILED:
+      return "SCALE compression: compressor failed to complete the data";
+  }
+  return "unknown SCALE CompressionError";
+}
+
+namespace scale {
+
+  gsl::span<const CompressionCodec *const> builtinCodecs() {
+    static const ZlibCodec zlib;
+    static const std::array<const CompressionCodec *, 1> codecs{&zlib};
+    return codecs;
+  }
+
+  CompressingSink::CompressingSink(EncoderSink &out,
+                                   const CompressionCodec &codec,
+                                   uint64_t size)
+      : out_{out}, compressor_{codec.compressor()}, remaining_{size} {
+    ScaleEncoderStream s{out_};
+    s << codec.id() << CompactInteger{size};
+    s.flush();
+  }
+
+  void CompressingSink::write(gsl::span<const uint8_t> bytes) {
+    if (static_cast<uint64_t>(bytes.size()) > remaining_) {
+      raise(CompressionError::SIZE_MISMATCH);
+    }
+    remaining_ -= bytes.size();
+    compressor_->compress(bytes, false, out_);
+  }
+
+  void CompressingSink::finish() {
+    if (remaining_ != 0) {
+      raise(CompressionError::SIZE_MISMATCH);
+    }
+    compressor_->compress({}, true, out_);
+  }
+
+  outcome::result<void> compressFrame(EncoderSink &out,
+                                      const CompressionCodec &codec,
+                                      gsl::span<const uint8_t> data) {
+    try {
+      CompressingSink sink{out, codec, static_cast<uint64_t>(data.size())};
+      sink.write(data);
+      sink.finish();
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return outcome::success();
+  }
+
+  DecompressingSource::DecompressingSource(
+      gsl::span<const uint8_t> body,
+      std::unique_ptr<Decompressor> decompressor,
+      uint64_t size)
+      : body_{body},
+        decompressor_{std::move(decompressor)},
+        size_{size},
+        remaining_{size},
+        finished_{false} {}
+
+  outcome::result<DecompressingSource> DecompressingSource::open(
+      gsl::span<const uint8_t> frame,
+      gsl::span<const CompressionCodec *const> codecs) {
+    uint8_t id = 0;
+    CompactInteger size;
+    ScaleDecoderStream s{frame};
+    try {
+      s >> id >> size;
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    if (size > std::numeric_limits<uint64_t>::max()) {
+      return CompressionError::TOO_LARGE;
+    }
+    auto codec = std::find_if(
+        codecs.begin(), codecs.end(), [id](const CompressionCodec *codec) {
+          return codec->id() == id;
+        });
+    if (codec == codecs.end()) {
+      return CompressionError::UNKNOWN_CODEC;
+    }
+    return DecompressingSource{frame.subspan(s.currentIndex()),
+                               (*codec)->decompressor(),
+                               size.convert_to<uint64_t>()};
+  }
+
+  outcome::result<gsl::span<uint8_t>> DecompressingSource::read(
+      gsl::span<uint8_t> chunk) {
+    auto output = chunk;
+    try {
+      while (not output.empty() and not finished_) {
+        auto input_size = body_.size();
+        auto output_size = output.size();
+        finished_ = decompressor_->decompress(body_, output);
+        if (not finished_ and body_.size() == input_size
+            and output.size() == output_size) {
+          // no progress, the body is truncated
+          return CompressionError::CORRUPTED_DATA;
+        }
+      }
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    auto produced = static_cast<uint64_t>(chunk.size() - output.size());
+    if (produced > remaining_ or (finished_ and produced < remaining_)) {
+      return CompressionError::SIZE_MISMATCH;
+    }
+    if (finished_ and not body_.empty()) {
+      return CompressionError::CORRUPTED_DATA;
+    }
+    remaining_ -= produced;
+    return chunk.first(produced);
+  }
+
+}  // namespace scale
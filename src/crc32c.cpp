@@ -0,0 +1,127 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "crc32c.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define SCALE_CRC32C_X86 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define SCALE_CRC32C_ARM 1
+#endif
+
+namespace scale::crc32c {
+  namespace {
+    // reflected Castagnoli polynomial
+    constexpr uint32_t kPolynomial = 0x82F63B78u;
+
+    // tables for slicing-by-8 software implementation
+    using Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+    const Tables &tables() {
+      static const Tables tables = [] {
+        Tables t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+          uint32_t crc = i;
+          for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1u) ^ ((crc & 1u) != 0 ? kPolynomial : 0u);
+          }
+          t[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+          for (size_t k = 1; k < 8; ++k) {
+            t[k][i] = (t[k - 1][i] >> 8u) ^ t[0][t[k - 1][i] & 0xFFu];
+          }
+        }
+        return t;
+      }();
+      return tables;
+    }
+
+    uint32_t extendSoftware(uint32_t crc, const uint8_t *p, size_t n) {
+      const auto &t = tables();
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      while (n >= 8) {
+        uint32_t low = 0;
+        uint32_t high = 0;
+        std::memcpy(&low, p, 4);
+        std::memcpy(&high, p + 4, 4);
+        low ^= crc;
+        crc = t[7][low & 0xFFu] ^ t[6][(low >> 8u) & 0xFFu]
+              ^ t[5][(low >> 16u) & 0xFFu] ^ t[4][low >> 24u]
+              ^ t[3][high & 0xFFu] ^ t[2][(high >> 8u) & 0xFFu]
+              ^ t[1][(high >> 16u) & 0xFFu] ^ t[0][high >> 24u];
+        p += 8;
+        n -= 8;
+      }
+      while (n-- > 0) {
+        crc = (crc >> 8u) ^ t[0][(crc ^ *p++) & 0xFFu];
+      }
+      // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return crc;
+    }
+
+#if defined(SCALE_CRC32C_X86)
+    __attribute__((target("sse4.2"))) uint32_t extendHardware(
+        uint32_t crc, const uint8_t *p, size_t n) {
+      uint64_t crc64 = crc;
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      while (n >= 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, p, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += 8;
+        n -= 8;
+      }
+      auto crc32 = static_cast<uint32_t>(crc64);
+      while (n-- > 0) {
+        crc32 = _mm_crc32_u8(crc32, *p++);
+      }
+      // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return crc32;
+    }
+
+    bool hasHardwareSupport() {
+      static const bool supported = __builtin_cpu_supports("sse4.2");
+      return supported;
+    }
+#elif defined(SCALE_CRC32C_ARM)
+    uint32_t extendHardware(uint32_t crc, const uint8_t *p, size_t n) {
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      while (n >= 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, p, 8);
+        crc = __crc32cd(crc, word);
+        p += 8;
+        n -= 8;
+      }
+      while (n-- > 0) {
+        crc = __crc32cb(crc, *p++);
+      }
+      // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return crc;
+    }
+
+    constexpr bool hasHardwareSupport() {
+      return true;
+    }
+#endif
+  }  // namespace
+
+  uint32_t extend(uint32_t crc, gsl::span<const uint8_t> data) {
+    auto size = static_cast<size_t>(data.size());
+    crc = ~crc;
+#if defined(SCALE_CRC32C_X86) || defined(SCALE_CRC32C_ARM)
+    if (hasHardwareSupport()) {
+      return ~extendHardware(crc, data.data(), size);
+    }
+#endif
+    return ~extendSoftware(crc, data.data(), size);
+  }
+}  // namespace scale::crc32c
@@ -0,0 +1,31 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCALE_CORE_SCALE_CRC32C_HPP
+#define SCALE_CORE_SCALE_CRC32C_HPP
+
+#include <cstdint>
+
+#include <gsl/span>
+
+namespace scale::crc32c {
+  /**
+   * @brief continues CRC32C (Castagnoli) computation, uses the CPU
+   * instruction when it is available
+   * @param crc checksum of the preceding data, 0 for the beginning
+   * @param data next chunk of data
+   * @return checksum of all the data
+   */
+  uint32_t extend(uint32_t crc, gsl::span<const uint8_t> data);
+
+  /**
+   * @return CRC32C checksum of the data
+   */
+  inline uint32_t compute(gsl::span<const uint8_t> data) {
+    return extend(0, data);
+  }
+}  // namespace scale::crc32c
+
+#endif  // SCALE_CORE_SCALE_CRC32C_HPP
@@ -0,0 +1,83 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/diff.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY_3(scale, DiffError, e) {
+  using scale::DiffError;
+  switch (e) {
+    case DiffError::INVALID_PATCH:
+      return "SCALE diff: splices of the patch overlap or are out of bounds";
+  }
+  return "unknown SCALE DiffError";
+}
+
+namespace scale {
+
+  namespace detail {
+    void DiffBuilder::replace(size_t old_begin,
+                              size_t old_end,
+                              size_t new_begin,
+                              size_t new_end) {
+      auto old_size = old_end - old_begin;
+      auto new_size = new_end - new_begin;
+      if (old_size == new_size
+          and (old_size == 0
+               or std::memcmp(&old_[old_begin], &new_[new_begin], old_size)
+                      == 0)) {
+        return;
+      }
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const auto *inserted = new_.data() + new_begin;
+      if (not patch_.empty()
+          and patch_.back().offset + patch_.back().removed == old_begin
+          and last_new_end_ == new_begin) {
+        auto &last = patch_.back();
+        last.removed += old_size;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        last.inserted.insert(
+            last.inserted.end(), inserted, inserted + new_size);
+      } else {
+        patch_.push_back(Splice{
+            old_begin,
+            old_size,
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            ByteArray(inserted, inserted + new_size)});
+      }
+      last_new_end_ = new_end;
+    }
+  }  // namespace detail
+
+  outcome::result<ByteArray> patch(gsl::span<const uint8_t> old_encoded,
+                                   const Patch &patch) {
+    auto old_size = static_cast<size_t>(old_encoded.size());
+    size_t new_size = old_size;
+    size_t position = 0;
+    for (const auto &splice : patch) {
+      if (splice.offset < position or splice.offset > old_size
+          or splice.removed > old_size - splice.offset) {
+        return DiffError::INVALID_PATCH;
+      }
+      position = splice.offset + splice.removed;
+      new_size += splice.inserted.size() - splice.removed;
+    }
+
+    ByteArray result;
+    result.reserve(new_size);
+    position = 0;
+    for (const auto &splice : patch) {
+      result.insert(result.end(),
+                    old_encoded.begin() + position,
+                    old_encoded.begin() + splice.offset);
+      result.insert(
+          result.end(), splice.inserted.begin(), splice.inserted.end());
+      position = splice.offset + splice.removed;
+    }
+    result.insert(
+        result.end(), old_encoded.begin() + position, old_encoded.end());
+    return result;
+  }
+
+}  // namespace scale
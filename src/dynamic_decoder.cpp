@@ -0,0 +1,484 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/dynamic_decoder.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "scale/scale_error.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY_3(scale::dynamic, DynamicTypeError, e) {
+  using scale::dynamic::DynamicTypeError;
+  switch (e) {
+    case DynamicTypeError::UNKNOWN_TYPE:
+      return "SCALE dynamic type: type is unknown or not defined";
+    case DynamicTypeError::NOT_AN_INTEGER:
+      return "SCALE dynamic type: compact type must wrap an unsigned integer";
+    case DynamicTypeError::INFINITE_TYPE:
+      return "SCALE dynamic type: composite type contains itself";
+    case DynamicTypeError::DUPLICATE_VARIANT:
+      return "SCALE dynamic type: variant arms have the same index";
+  }
+  return "unknown SCALE DynamicTypeError";
+}
+
+namespace scale::dynamic {
+
+  TypeId TypeRegistry::add(TypeDef def) {
+    types_.emplace_back(std::move(def));
+    return types_.size() - 1;
+  }
+
+  TypeId TypeRegistry::reserve() {
+    types_.emplace_back();
+    return types_.size() - 1;
+  }
+
+  void TypeRegistry::define(TypeId id, TypeDef def) {
+    types_.at(id) = std::move(def);
+  }
+
+  const TypeDef *TypeRegistry::find(TypeId id) const {
+    if (id >= types_.size() or not types_[id]) {
+      return nullptr;
+    }
+    return &*types_[id];
+  }
+
+  /**
+   * Compiles types into programs of a plan. Composites and tuples are
+   * inlined into the program of the enclosing type, elements of collections
+   * and variant arms get programs of their own, so that recursive types are
+   * compiled once.
+   */
+  class PlanCompiler {
+    using Op = DecodePlan::Op;
+    using Instruction = DecodePlan::Instruction;
+    using Code = std::vector<Instruction>;
+
+   public:
+    PlanCompiler(const TypeRegistry &registry, DecodePlan &plan)
+        : registry_{registry}, plan_{plan} {}
+
+    outcome::result<uint32_t> program(TypeId type) {
+      if (auto it = programs_.find(type); it != programs_.end()) {
+        return it->second;
+      }
+      auto id = newProgram();
+      programs_.emplace(type, id);
+      Code code;
+      OUTCOME_TRY(emitProgram(type, code));
+      plan_.programs_[id] = std::move(code);
+      return id;
+    }
+
+   private:
+    uint32_t newProgram() {
+      plan_.programs_.emplace_back();
+      return plan_.programs_.size() - 1;
+    }
+
+    // a program of its own is not inlined into the enclosing types, so they
+    // may appear in it again, e.g. Node { child: Option<Node> }
+    outcome::result<void> emitProgram(TypeId type, Code &code) {
+      auto inlined = std::exchange(inlined_, {});
+      auto res = emit(type, code);
+      inlined_ = std::move(inlined);
+      return res;
+    }
+
+    outcome::result<void> emit(TypeId type, Code &code) {
+      const auto *def = registry_.find(type);
+      if (def == nullptr) {
+        return DynamicTypeError::UNKNOWN_TYPE;
+      }
+      if (const auto *variant = boost::get<VariantType>(def)) {
+        return emitVariant(type, *variant, code);
+      }
+      // only inlined types can lead to infinite recursion here
+      if (not inlined_.insert(type).second) {
+        return DynamicTypeError::INFINITE_TYPE;
+      }
+      auto res = boost::apply_visitor(
+          [&](const auto &t) { return emitType(t, code); }, *def);
+      inlined_.erase(type);
+      return res;
+    }
+
+    // arms of a variant get programs of their own, the table of arms is
+    // shared by all references to the variant type
+    outcome::result<void> emitVariant(TypeId type,
+                                      const VariantType &variant,
+                                      Code &code) {
+      if (auto it = tables_.find(type); it != tables_.end()) {
+        code.push_back({Op::VARIANT, it->second, 0});
+        return outcome::success();
+      }
+      auto table_id = static_cast<uint32_t>(plan_.variant_tables_.size());
+      plan_.variant_tables_.emplace_back();
+      tables_.emplace(type, table_id);
+      DecodePlan::VariantTable table;
+      table.fill(-1);
+      for (const auto &arm : variant.arms) {
+        if (table.at(arm.index) != -1) {
+          return DynamicTypeError::DUPLICATE_VARIANT;
+        }
+        auto id = newProgram();
+        table.at(arm.index) = static_cast<int32_t>(id);
+        Code arm_code;
+        for (auto field : arm.fields) {
+          OUTCOME_TRY(emitProgram(field, arm_code));
+        }
+        plan_.programs_[id] = std::move(arm_code);
+      }
+      plan_.variant_tables_[table_id] = table;
+      code.push_back({Op::VARIANT, table_id, 0});
+      return outcome::success();
+    }
+
+    outcome::result<void> emitType(Primitive primitive, Code &code) {
+      static constexpr std::array<Op, 12> kOps{Op::BOOL,
+                                               Op::U8,
+                                               Op::U16,
+                                               Op::U32,
+                                               Op::U64,
+                                               Op::U128,
+                                               Op::I8,
+                                               Op::I16,
+                                               Op::I32,
+                                               Op::I64,
+                                               Op::I128,
+                                               Op::STR};
+      code.push_back({kOps.at(static_cast<size_t>(primitive)), 0, 0});
+      return outcome::success();
+    }
+
+    outcome::result<void> emitType(const CompositeType &composite,
+                                   Code &code) {
+      code.push_back({Op::BEGIN_COMPOSITE,
+                      0,
+                      static_cast<uint32_t>(composite.fields.size())});
+      for (const auto &field : composite.fields) {
+        OUTCOME_TRY(emit(field.second, code));
+      }
+      code.push_back({Op::END_COMPOSITE, 0, 0});
+      return outcome::success();
+    }
+
+    outcome::result<void> emitType(const TupleType &tuple, Code &code) {
+      code.push_back({Op::BEGIN_COMPOSITE,
+                      0,
+                      static_cast<uint32_t>(tuple.elements.size())});
+      for (auto element : tuple.elements) {
+        OUTCOME_TRY(emit(element, code));
+      }
+      code.push_back({Op::END_COMPOSITE, 0, 0});
+      return outcome::success();
+    }
+
+    outcome::result<void> emitType(const VariantType & /*unused*/,
+                                   Code & /*unused*/) {
+      // handled by emitVariant
+      return outcome::success();
+    }
+
+    outcome::result<void> emitType(const SequenceType &sequence, Code &code) {
+      if (isByte(sequence.element)) {
+        code.push_back({Op::BYTES_SEQUENCE, 0, 0});
+        return outcome::success();
+      }
+      OUTCOME_TRY(element, program(sequence.element));
+      code.push_back({Op::SEQUENCE, element, 0});
+      return outcome::success();
+    }
+
+    outcome::result<void> emitType(const ArrayType &array, Code &code) {
+      if (isByte(array.element)) {
+        code.push_back({Op::BYTES_ARRAY, 0, array.length});
+        return outcome::success();
+      }
+      OUTCOME_TRY(element, program(array.element));
+      code.push_back({Op::ARRAY, element, array.length});
+      return outcome::success();
+    }
+
+    outcome::result<void> emitType(const CompactType &compact, Code &code) {
+      const auto *def = registry_.find(compact.integer);
+      if (def == nullptr) {
+        return DynamicTypeError::UNKNOWN_TYPE;
+      }
+      const auto *primitive = boost::get<Primitive>(def);
+      if (primitive == nullptr or *primitive < Primitive::U8
+          or *primitive > Primitive::U128) {
+        return DynamicTypeError::NOT_AN_INTEGER;
+      }
+      code.push_back({Op::COMPACT, 0, 0});
+      return outcome::success();
+    }
+
+    bool isByte(TypeId type) const {
+      const auto *def = registry_.find(type);
+      if (def == nullptr) {
+        return false;
+      }
+      const auto *primitive = boost::get<Primitive>(def);
+      return primitive != nullptr and *primitive == Primitive::U8;
+    }
+
+    const TypeRegistry &registry_;
+    DecodePlan &plan_;
+    std::unordered_map<TypeId, uint32_t> programs_;
+    std::unordered_map<TypeId, uint32_t> tables_;
+    std::unordered_set<TypeId> inlined_;
+  };
+
+  namespace {
+    /**
+     * Builds Value tree from visited values
+     */
+    class ValueBuilder final : public Visitor {
+     public:
+      ValueBuilder() : frames_(1) {}
+
+      void onBool(bool v) override {
+        add(Value{v});
+      }
+
+      void onUnsigned(uint64_t v) override {
+        add(Value{v});
+      }
+
+      void onSigned(int64_t v) override {
+        add(Value{v});
+      }
+
+      void onBigInteger(const CompactInteger &v) override {
+        add(Value{v});
+      }
+
+      void onString(std::string_view v) override {
+        add(Value{std::string{v}});
+      }
+
+      void onBytes(gsl::span<const uint8_t> v) override {
+        add(Value{ByteArray{v.begin(), v.end()}});
+      }
+
+      void beginComposite(size_t fields) override {
+        begin(fields);
+      }
+
+      void endComposite() override {
+        add(Value{end()});
+      }
+
+      void beginSequence(size_t elements) override {
+        // the count comes from untrusted data
+        begin(std::min<size_t>(elements, kMaxReserve));
+      }
+
+      void endSequence() override {
+        add(Value{end()});
+      }
+
+      void beginVariant(uint8_t index) override {
+        indices_.push_back(index);
+        begin(0);
+      }
+
+      void endVariant() override {
+        VariantValue variant{indices_.back(), end()};
+        indices_.pop_back();
+        add(Value{std::move(variant)});
+      }
+
+      Value result() {
+        return std::move(frames_.front().front());
+      }
+
+     private:
+      static constexpr size_t kMaxReserve = 1024;
+
+      void add(Value v) {
+        frames_.back().push_back(std::move(v));
+      }
+
+      void begin(size_t reserve) {
+        frames_.emplace_back();
+        frames_.back().reserve(reserve);
+      }
+
+      std::vector<Value> end() {
+        auto values = std::move(frames_.back());
+        frames_.pop_back();
+        return values;
+      }
+
+      std::vector<std::vector<Value>> frames_;
+      std::vector<uint8_t> indices_;
+    };
+
+    template <class T>
+    T decodeFixed(ScaleDecoderStream &stream) {
+      T v{};
+      stream >> v;
+      return v;
+    }
+
+    CompactInteger decodeInt128(ScaleDecoderStream &stream, bool is_signed) {
+      auto bytes = stream.nextBytes(16);
+      CompactInteger v;
+      for (auto it = bytes.rbegin(); it != bytes.rend(); ++it) {
+        v <<= 8;
+        v |= *it;
+      }
+      if (is_signed and (bytes[15] & 0x80u) != 0) {
+        v -= CompactInteger{1} << 128;
+      }
+      return v;
+    }
+
+    size_t decodeLength(ScaleDecoderStream &stream) {
+      CompactInteger length;
+      stream >> length;
+      if (length > std::numeric_limits<uint32_t>::max()) {
+        raise(DecodeError::TOO_MANY_ITEMS);
+      }
+      return length.convert_to<size_t>();
+    }
+  }  // namespace
+
+  outcome::result<DecodePlan> DecodePlan::compile(const TypeRegistry &registry,
+                                                  TypeId type) {
+    DecodePlan plan;
+    PlanCompiler compiler{registry, plan};
+    OUTCOME_TRY(root, compiler.program(type));
+    // the root type program must be the first one
+    BOOST_ASSERT(root == 0);
+    return plan;
+  }
+
+  void DecodePlan::run(ScaleDecoderStream &stream, Visitor &visitor) const {
+    execute(0, stream, visitor, 0);
+  }
+
+  Value DecodePlan::decode(ScaleDecoderStream &stream) const {
+    ValueBuilder builder;
+    run(stream, builder);
+    return builder.result();
+  }
+
+  outcome::result<Value> DecodePlan::decode(
+      gsl::span<const uint8_t> bytes) const {
+    ScaleDecoderStream stream{bytes};
+    try {
+      return decode(stream);
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+  }
+
+  void DecodePlan::execute(uint32_t program,
+                           ScaleDecoderStream &stream,
+                           Visitor &visitor,
+                           size_t depth) const {
+    if (depth > kMaxNestingDepth) {
+      raise(DecodeError::TOO_DEEP_NESTING);
+    }
+    for (const auto &instruction : programs_[program]) {
+      switch (instruction.op) {
+        case Op::BOOL:
+          visitor.onBool(decodeFixed<bool>(stream));
+          break;
+        case Op::U8:
+          visitor.onUnsigned(decodeFixed<uint8_t>(stream));
+          break;
+        case Op::U16:
+          visitor.onUnsigned(decodeFixed<uint16_t>(stream));
+          break;
+        case Op::U32:
+          visitor.onUnsigned(decodeFixed<uint32_t>(stream));
+          break;
+        case Op::U64:
+          visitor.onUnsigned(decodeFixed<uint64_t>(stream));
+          break;
+        case Op::U128:
+          visitor.onBigInteger(decodeInt128(stream, false));
+          break;
+        case Op::I8:
+          visitor.onSigned(decodeFixed<int8_t>(stream));
+          break;
+        case Op::I16:
+          visitor.onSigned(decodeFixed<int16_t>(stream));
+          break;
+        case Op::I32:
+          visitor.onSigned(decodeFixed<int32_t>(stream));
+          break;
+        case Op::I64:
+          visitor.onSigned(decodeFixed<int64_t>(stream));
+          break;
+        case Op::I128:
+          visitor.onBigInteger(decodeInt128(stream, true));
+          break;
+        case Op::STR: {
+          auto bytes = stream.nextBytes(decodeLength(stream));
+          visitor.onString(std::string_view{
+              // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+              reinterpret_cast<const char *>(bytes.data()),
+              static_cast<size_t>(bytes.size())});
+          break;
+        }
+        case Op::COMPACT: {
+          CompactInteger v;
+          stream >> v;
+          if (v <= std::numeric_limits<uint64_t>::max()) {
+            visitor.onUnsigned(v.convert_to<uint64_t>());
+          } else {
+            visitor.onBigInteger(v);
+          }
+          break;
+        }
+        case Op::BYTES_SEQUENCE:
+          visitor.onBytes(stream.nextBytes(decodeLength(stream)));
+          break;
+        case Op::BYTES_ARRAY:
+          visitor.onBytes(stream.nextBytes(instruction.count));
+          break;
+        case Op::BEGIN_COMPOSITE:
+          visitor.beginComposite(instruction.count);
+          break;
+        case Op::END_COMPOSITE:
+          visitor.endComposite();
+          break;
+        case Op::SEQUENCE:
+        case Op::ARRAY: {
+          auto count = instruction.op == Op::SEQUENCE ? decodeLength(stream)
+                                                      : instruction.count;
+          visitor.beginSequence(count);
+          for (size_t i = 0; i < count; ++i) {
+            execute(instruction.target, stream, visitor, depth + 1);
+          }
+          visitor.endSequence();
+          break;
+        }
+        case Op::VARIANT: {
+          auto index = stream.nextByte();
+          auto arm = variant_tables_[instruction.target].at(index);
+          if (arm < 0) {
+            raise(DecodeError::WRONG_TYPE_INDEX);
+          }
+          visitor.beginVariant(index);
+          execute(arm, stream, visitor, depth + 1);
+          visitor.endVariant();
+          break;
+        }
+      }
+    }
+  }
+
+}  // namespace scale::dynamic
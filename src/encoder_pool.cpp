@@ -0,0 +1,40 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/encoder_pool.hpp"
+
+#include <vector>
+
+namespace scale {
+
+  namespace {
+    std::vector<std::unique_ptr<ScaleEncoderStream>> &threadPool() {
+      thread_local std::vector<std::unique_ptr<ScaleEncoderStream>> pool;
+      return pool;
+    }
+  }  // namespace
+
+  EncoderPool::Lease EncoderPool::acquire() {
+    auto &pool = threadPool();
+    if (pool.empty()) {
+      return Lease{std::make_unique<ScaleEncoderStream>()};
+    }
+    auto stream = std::move(pool.back());
+    pool.pop_back();
+    return Lease{std::move(stream)};
+  }
+
+  void EncoderPool::release(std::unique_ptr<ScaleEncoderStream> stream) {
+    auto &pool = threadPool();
+    if (pool.size() >= kMaxPooledStreams
+        or stream->capacity() > kMaxRetainedCapacity) {
+      return;
+    }
+    stream->reset();
+    stream->setSizeLimit(ScaleEncoderStream::kNoSizeLimit);
+    pool.push_back(std::move(stream));
+  }
+
+}  // namespace scale
@@ -0,0 +1,130 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/encoding_cache.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/container_hash/hash.hpp>
+
+namespace scale {
+
+  EncodingCache::EncodingCache(size_t byte_budget, size_t shards) {
+    shards = std::max<size_t>(shards, 1);
+    shards_.reserve(shards);
+    for (size_t i = 0; i < shards; ++i) {
+      shards_.emplace_back(std::make_unique<Shard>(byte_budget / shards));
+    }
+  }
+
+  void EncodingCache::erase(const void *object) {
+    shardOf(object).erase(object);
+  }
+
+  size_t EncodingCache::size() const {
+    size_t size = 0;
+    for (const auto &shard : shards_) {
+      size += shard->size();
+    }
+    return size;
+  }
+
+  void EncodingCache::clear() {
+    for (auto &shard : shards_) {
+      shard->clear();
+    }
+  }
+
+  EncodingCache::Shard &EncodingCache::shardOf(const void *object) {
+    // addresses are aligned, so they are mixed before taking the remainder
+    size_t seed = 0;
+    boost::hash_combine(seed, object);
+    return *shards_[seed % shards_.size()];
+  }
+
+  EncodingCache::Entry EncodingCache::Shard::find(const Key &key) {
+    std::lock_guard lock{mutex_};
+    auto object = index_.find(key.object);
+    if (object == index_.end()) {
+      return nullptr;
+    }
+    for (auto it : object->second) {
+      if (it->first.type == key.type) {
+        if (it->first.version != key.version) {
+          return nullptr;
+        }
+        lru_.splice(lru_.begin(), lru_, it);
+        return it->second;
+      }
+    }
+    return nullptr;
+  }
+
+  void EncodingCache::Shard::insert(const Key &key, Entry entry) {
+    if (entry->size() > byte_budget_) {
+      return;
+    }
+    std::lock_guard lock{mutex_};
+    auto &entries = index_[key.object];
+    auto same_type =
+        std::find_if(entries.begin(), entries.end(), [&](auto it) {
+          return it->first.type == key.type;
+        });
+    if (same_type != entries.end()) {
+      if ((*same_type)->first.version >= key.version) {
+        // inserted concurrently or outdated
+        return;
+      }
+      remove(entries, same_type);
+    }
+    size_ += entry->size();
+    lru_.emplace_front(key, std::move(entry));
+    entries.push_back(lru_.begin());
+    while (size_ > byte_budget_) {
+      auto oldest = std::prev(lru_.end());
+      const auto *object = oldest->first.object;
+      auto &object_entries = index_.at(object);
+      remove(object_entries,
+             std::find(object_entries.begin(), object_entries.end(), oldest));
+      if (object_entries.empty()) {
+        index_.erase(object);
+      }
+    }
+  }
+
+  void EncodingCache::Shard::erase(const void *object) {
+    std::lock_guard lock{mutex_};
+    auto it = index_.find(object);
+    if (it == index_.end()) {
+      return;
+    }
+    for (auto entry : it->second) {
+      size_ -= entry->second->size();
+      lru_.erase(entry);
+    }
+    index_.erase(it);
+  }
+
+  void EncodingCache::Shard::remove(ObjectEntries &entries,
+                                    ObjectEntries::iterator it) {
+    size_ -= (*it)->second->size();
+    lru_.erase(*it);
+    entries.erase(it);
+  }
+
+  size_t EncodingCache::Shard::size() const {
+    std::lock_guard lock{mutex_};
+    return size_;
+  }
+
+  void EncodingCache::Shard::clear() {
+    std::lock_guard lock{mutex_};
+    lru_.clear();
+    index_.clear();
+    size_ = 0;
+  }
+
+}  // namespace scale
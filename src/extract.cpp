@@ -0,0 +1,17 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/extract.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY_3(scale, ExtractError, e) {
+  using scale::ExtractError;
+  switch (e) {
+    case ExtractError::ARM_MISMATCH:
+      return "SCALE extract: variant holds another arm than the path expects";
+    case ExtractError::INDEX_OUT_OF_RANGE:
+      return "SCALE extract: collection has fewer elements than the index";
+  }
+  return "unknown SCALE ExtractError";
+}
@@ -0,0 +1,276 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/hashing_sinks.hpp"
+
+#include <cstring>
+
+namespace scale {
+  namespace {
+    constexpr std::array<uint64_t, 8> kBlake2bIv{0x6a09e667f3bcc908ull,
+                                                 0xbb67ae8584caa73bull,
+                                                 0x3c6ef372fe94f82bull,
+                                                 0xa54ff53a5f1d36f1ull,
+                                                 0x510e527fade682d1ull,
+                                                 0x9b05688c2b3e6c1full,
+                                                 0x1f83d9abfb41bd6bull,
+                                                 0x5be0cd19137e2179ull};
+
+    constexpr std::array<std::array<uint8_t, 16>, 12> kBlake2bSigma{{
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+        {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+        {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+        {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+        {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+        {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+        {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+        {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+        {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+        {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+        {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    }};
+
+    // output length 32, no key, fanout and depth 1
+    constexpr uint64_t kBlake2b256Params = 0x01010020;
+
+    constexpr uint64_t kPrime1 = 11400714785074694791ull;
+    constexpr uint64_t kPrime2 = 14029467366897019727ull;
+    constexpr uint64_t kPrime3 = 1609587929392839161ull;
+    constexpr uint64_t kPrime4 = 9650029242287828579ull;
+    constexpr uint64_t kPrime5 = 2870177450012600261ull;
+
+    uint64_t rotr(uint64_t x, unsigned n) {
+      return (x >> n) | (x << (64u - n));
+    }
+
+    uint64_t rotl(uint64_t x, unsigned n) {
+      return (x << n) | (x >> (64u - n));
+    }
+
+    uint64_t load64(const uint8_t *in) {
+      uint64_t v = 0;
+      for (size_t i = 0; i < 8; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        v |= static_cast<uint64_t>(in[i]) << (8 * i);
+      }
+      return v;
+    }
+
+    uint32_t load32(const uint8_t *in) {
+      uint32_t v = 0;
+      for (size_t i = 0; i < 4; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        v |= static_cast<uint32_t>(in[i]) << (8 * i);
+      }
+      return v;
+    }
+
+    void store64(uint8_t *out, uint64_t v) {
+      for (size_t i = 0; i < 8; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out[i] = static_cast<uint8_t>(v >> (8 * i));
+      }
+    }
+
+    uint64_t xxRound(uint64_t acc, uint64_t input) {
+      acc += input * kPrime2;
+      acc = rotl(acc, 31);
+      return acc * kPrime1;
+    }
+
+    uint64_t xxMerge(uint64_t acc, uint64_t v) {
+      acc ^= xxRound(0, v);
+      return acc * kPrime1 + kPrime4;
+    }
+  }  // namespace
+
+  Blake2b256Sink::Blake2b256Sink()
+      : state_{kBlake2bIv}, counter_{0}, block_{}, block_size_{0} {
+    state_[0] ^= kBlake2b256Params;
+  }
+
+  void Blake2b256Sink::write(gsl::span<const uint8_t> bytes) {
+    const auto *in = bytes.data();
+    auto size = static_cast<size_t>(bytes.size());
+    if (size == 0) {
+      return;
+    }
+    if (block_size_ + size <= kBlockSize) {
+      std::memcpy(&block_[block_size_], in, size);
+      block_size_ += size;
+      return;
+    }
+    // a full block is compressed only when more data follows
+    auto fill = kBlockSize - block_size_;
+    std::memcpy(&block_[block_size_], in, fill);
+    compress(block_.data(), kBlockSize, false);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    in += fill;
+    size -= fill;
+    while (size > kBlockSize) {
+      compress(in, kBlockSize, false);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      in += kBlockSize;
+      size -= kBlockSize;
+    }
+    std::memcpy(block_.data(), in, size);
+    block_size_ = size;
+  }
+
+  Blake2b256Sink::Hash Blake2b256Sink::finish() {
+    std::memset(&block_[block_size_], 0, kBlockSize - block_size_);
+    compress(block_.data(), block_size_, true);
+    Hash hash{};
+    for (size_t i = 0; i < hash.size() / 8; ++i) {
+      store64(&hash[i * 8], state_[i]);
+    }
+    return hash;
+  }
+
+  void Blake2b256Sink::compress(const uint8_t *block,
+                                size_t size,
+                                bool last) {
+    counter_ += size;
+    std::array<uint64_t, 16> m{};
+    for (size_t i = 0; i < m.size(); ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      m[i] = load64(block + i * 8);
+    }
+    std::array<uint64_t, 16> v{};
+    std::copy(state_.begin(), state_.end(), v.begin());
+    std::copy(kBlake2bIv.begin(), kBlake2bIv.end(), v.begin() + 8);
+    v[12] ^= counter_;
+    if (last) {
+      v[14] = ~v[14];
+    }
+    auto g = [&v](size_t a, size_t b, size_t c, size_t d, uint64_t x,
+                  uint64_t y) {
+      v[a] = v[a] + v[b] + x;
+      v[d] = rotr(v[d] ^ v[a], 32);
+      v[c] = v[c] + v[d];
+      v[b] = rotr(v[b] ^ v[c], 24);
+      v[a] = v[a] + v[b] + y;
+      v[d] = rotr(v[d] ^ v[a], 16);
+      v[c] = v[c] + v[d];
+      v[b] = rotr(v[b] ^ v[c], 63);
+    };
+    for (const auto &s : kBlake2bSigma) {
+      g(0, 4, 8, 12, m[s[0]], m[s[1]]);
+      g(1, 5, 9, 13, m[s[2]], m[s[3]]);
+      g(2, 6, 10, 14, m[s[4]], m[s[5]]);
+      g(3, 7, 11, 15, m[s[6]], m[s[7]]);
+      g(0, 5, 10, 15, m[s[8]], m[s[9]]);
+      g(1, 6, 11, 12, m[s[10]], m[s[11]]);
+      g(2, 7, 8, 13, m[s[12]], m[s[13]]);
+      g(3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+    for (size_t i = 0; i < state_.size(); ++i) {
+      state_[i] ^= v[i] ^ v[i + 8];
+    }
+  }
+
+  XxHash64Sink::XxHash64Sink(uint64_t seed)
+      : seed_{seed},
+        accumulators_{seed + kPrime1 + kPrime2, seed + kPrime2, seed,
+                      seed - kPrime1},
+        total_size_{0},
+        stripe_{},
+        stripe_size_{0} {}
+
+  void XxHash64Sink::write(gsl::span<const uint8_t> bytes) {
+    const auto *in = bytes.data();
+    auto size = static_cast<size_t>(bytes.size());
+    total_size_ += size;
+    auto consume = [this](const uint8_t *stripe) {
+      for (size_t i = 0; i < accumulators_.size(); ++i) {
+        accumulators_[i] =
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            xxRound(accumulators_[i], load64(stripe + i * 8));
+      }
+    };
+    if (stripe_size_ + size < kStripeSize) {
+      if (size != 0) {
+        std::memcpy(&stripe_[stripe_size_], in, size);
+      }
+      stripe_size_ += size;
+      return;
+    }
+    if (stripe_size_ != 0) {
+      auto fill = kStripeSize - stripe_size_;
+      std::memcpy(&stripe_[stripe_size_], in, fill);
+      consume(stripe_.data());
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      in += fill;
+      size -= fill;
+    }
+    while (size >= kStripeSize) {
+      consume(in);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      in += kStripeSize;
+      size -= kStripeSize;
+    }
+    if (size != 0) {
+      std::memcpy(stripe_.data(), in, size);
+    }
+    stripe_size_ = size;
+  }
+
+  XxHash64Sink::Hash XxHash64Sink::finish() const {
+    uint64_t hash = 0;
+    if (total_size_ >= kStripeSize) {
+      const auto &acc = accumulators_;
+      hash = rotl(acc[0], 1) + rotl(acc[1], 7) + rotl(acc[2], 12)
+             + rotl(acc[3], 18);
+      for (auto v : acc) {
+        hash = xxMerge(hash, v);
+      }
+    } else {
+      hash = seed_ + kPrime5;
+    }
+    hash += total_size_;
+
+    const auto *p = stripe_.data();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto *end = p + stripe_size_;
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (; p + 8 <= end; p += 8) {
+      hash ^= xxRound(0, load64(p));
+      hash = rotl(hash, 27) * kPrime1 + kPrime4;
+    }
+    if (p + 4 <= end) {
+      hash ^= static_cast<uint64_t>(load32(p)) * kPrime1;
+      hash = rotl(hash, 23) * kPrime2 + kPrime3;
+      p += 4;
+    }
+    for (; p < end; ++p) {
+      hash ^= *p * kPrime5;
+      hash = rotl(hash, 11) * kPrime1;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+  Twox128Sink::Twox128Sink() : first_{0}, second_{1} {}
+
+  void Twox128Sink::write(gsl::span<const uint8_t> bytes) {
+    first_.write(bytes);
+    second_.write(bytes);
+  }
+
+  Twox128Sink::Hash Twox128Sink::finish() const {
+    Hash hash{};
+    store64(hash.data(), first_.finish());
+    store64(&hash[8], second_.finish());
+    return hash;
+  }
+
+}  // namespace scale
@@ -0,0 +1,166 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/mapped_record_reader.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include "scale/outcome/outcome_throw.hpp"
+
+namespace scale {
+  namespace {
+    std::error_code lastSystemError() {
+      return {errno, std::generic_category()};
+    }
+  }  // namespace
+
+  outcome::result<MappedFile> MappedFile::open(const std::string &path) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return outcome::failure(lastSystemError());
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      auto error = lastSystemError();
+      ::close(fd);
+      return outcome::failure(error);
+    }
+    auto size = static_cast<size_t>(st.st_size);
+    // empty files cannot be mapped
+    if (size == 0) {
+      ::close(fd);
+      return MappedFile{nullptr, 0};
+    }
+    void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    auto error = lastSystemError();
+    ::close(fd);
+    if (data == MAP_FAILED) {  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+      return outcome::failure(error);
+    }
+    return MappedFile{static_cast<const uint8_t *>(data), size};
+  }
+
+  MappedFile::MappedFile(const uint8_t *data, size_t size)
+      : data_{data}, size_{size} {}
+
+  MappedFile::MappedFile(MappedFile &&other) noexcept
+      : data_{other.data_}, size_{other.size_} {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+      reset();
+      data_ = other.data_;
+      size_ = other.size_;
+      other.data_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  MappedFile::~MappedFile() {
+    reset();
+  }
+
+  void MappedFile::reset() {
+    if (data_ != nullptr) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      ::munmap(const_cast<uint8_t *>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  gsl::span<const uint8_t> MappedFile::data() const {
+    return gsl::make_span(data_, size_);
+  }
+
+  void MappedFile::adviseSequential() const {
+    if (data_ != nullptr) {
+      // only a hint, failure does not affect reading
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      ::madvise(const_cast<uint8_t *>(data_), size_, MADV_SEQUENTIAL);
+    }
+  }
+
+  outcome::result<MappedRecordReader> MappedRecordReader::open(
+      const std::string &path, bool sequential) {
+    OUTCOME_TRY(file, MappedFile::open(path));
+    if (sequential) {
+      file.adviseSequential();
+    }
+    return MappedRecordReader{std::move(file)};
+  }
+
+  MappedRecordReader::MappedRecordReader(MappedFile file)
+      : file_{std::move(file)}, stream_{file_.data()} {}
+
+  outcome::result<std::optional<gsl::span<const uint8_t>>>
+  MappedRecordReader::nextRecord() {
+    if (atEnd()) {
+      return std::nullopt;
+    }
+    try {
+      CompactInteger length;
+      stream_ >> length;
+      if (not stream_.hasMore(length.convert_to<uint64_t>())) {
+        raise(DecodeError::NOT_ENOUGH_DATA);
+      }
+      return stream_.nextBytes(length.convert_to<ScaleDecoderStream::SizeType>());
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+  }
+
+  bool MappedRecordReader::atEnd() const {
+    return not stream_.hasMore(1);
+  }
+
+  size_t MappedRecordReader::offset() const {
+    return stream_.currentIndex();
+  }
+
+  void MappedRecordReader::rewind() {
+    stream_ = ScaleDecoderStream{file_.data()};
+  }
+
+  gsl::span<const uint8_t> MappedRecordReader::data() const {
+    return file_.data();
+  }
+
+  MappedRecordReader::Iterator MappedRecordReader::begin() {
+    return Iterator{this};
+  }
+
+  MappedRecordReader::Iterator MappedRecordReader::end() {
+    return Iterator{nullptr};
+  }
+
+  MappedRecordReader::Iterator::Iterator(MappedRecordReader *reader)
+      : reader_{reader} {
+    if (reader_ != nullptr) {
+      ++*this;
+    }
+  }
+
+  MappedRecordReader::Iterator &MappedRecordReader::Iterator::operator++() {
+    auto record = reader_->nextRecord();
+    if (record.has_error()) {
+      raise(record.error());
+    }
+    record_ = record.value();
+    return *this;
+  }
+
+}  // namespace scale
@@ -0,0 +1,312 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/record_log.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include "compact_len_utils.hpp"
+#include "crc32c.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY_3(scale, RecordLogError, e) {
+  using scale::RecordLogError;
+  switch (e) {
+    case RecordLogError::CHECKSUM_MISMATCH:
+      return "SCALE record log: record checksum mismatch";
+    case RecordLogError::INDEX_OUT_OF_RANGE:
+      return "SCALE record log: record number is out of range";
+    case RecordLogError::INDEX_CORRUPTED:
+      return "SCALE record log: index points outside the data file";
+  }
+  return "unknown SCALE RecordLogError";
+}
+
+namespace scale {
+  namespace {
+    // space reserved for the record length, enough for records up to 1 GiB
+    constexpr size_t kReservedLengthSize = 4;
+    constexpr size_t kChecksumSize = 4;
+    constexpr size_t kIndexEntrySize = 8;
+
+    std::error_code lastSystemError() {
+      return {errno, std::generic_category()};
+    }
+
+    void putLittleEndian(uint8_t *out, uint64_t value, size_t size) {
+      for (size_t i = 0; i < size; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+      }
+    }
+
+    uint64_t getLittleEndian(const uint8_t *in, size_t size) {
+      uint64_t value = 0;
+      for (size_t i = 0; i < size; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+      }
+      return value;
+    }
+
+    outcome::result<void> writeAll(int fd, const std::vector<uint8_t> &data) {
+      size_t written = 0;
+      while (written < data.size()) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto res = ::write(fd, data.data() + written, data.size() - written);
+        if (res < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          return outcome::failure(lastSystemError());
+        }
+        written += static_cast<size_t>(res);
+      }
+      return outcome::success();
+    }
+
+    // drops data partially written before a failure, which is already
+    // being reported
+    void truncate(int fd, uint64_t size) {
+      [[maybe_unused]] auto res = ::ftruncate(fd, static_cast<off_t>(size));
+    }
+
+    outcome::result<int> openForAppend(const std::string &path) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+      int fd = ::open(path.c_str(),
+                      O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+                      S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+      if (fd < 0) {
+        return outcome::failure(lastSystemError());
+      }
+      return fd;
+    }
+
+    outcome::result<uint64_t> fileSize(int fd) {
+      struct stat st {};
+      if (::fstat(fd, &st) != 0) {
+        return outcome::failure(lastSystemError());
+      }
+      return static_cast<uint64_t>(st.st_size);
+    }
+  }  // namespace
+
+  outcome::result<RecordLogWriter> RecordLogWriter::open(
+      const std::string &path, Options options) {
+    OUTCOME_TRY(data_fd, openForAppend(path));
+    auto index_fd = openForAppend(path + ".idx");
+    if (not index_fd) {
+      ::close(data_fd);
+      return index_fd.as_failure();
+    }
+    RecordLogWriter writer{data_fd, index_fd.value(), 0, 0, options};
+    OUTCOME_TRY(data_size, fileSize(data_fd));
+    OUTCOME_TRY(index_size, fileSize(index_fd.value()));
+    writer.data_size_ = data_size;
+    writer.records_ = index_size / kIndexEntrySize;
+    return writer;
+  }
+
+  RecordLogWriter::RecordLogWriter(int data_fd,
+                                   int index_fd,
+                                   uint64_t data_size,
+                                   uint64_t records,
+                                   Options options)
+      : data_fd_{data_fd},
+        index_fd_{index_fd},
+        options_{options},
+        data_size_{data_size},
+        records_{records},
+        unsynced_records_{0} {
+    buffer_.reserve(options_.buffer_size);
+  }
+
+  RecordLogWriter::RecordLogWriter(RecordLogWriter &&other) noexcept
+      : data_fd_{other.data_fd_},
+        index_fd_{other.index_fd_},
+        options_{other.options_},
+        data_size_{other.data_size_},
+        records_{other.records_},
+        unsynced_records_{other.unsynced_records_},
+        buffer_{std::move(other.buffer_)},
+        index_buffer_{std::move(other.index_buffer_)} {
+    other.data_fd_ = -1;
+    other.index_fd_ = -1;
+  }
+
+  RecordLogWriter::~RecordLogWriter() {
+    if (data_fd_ < 0) {
+      return;
+    }
+    // nothing to do with an error here, sync() must be used to be sure
+    [[maybe_unused]] auto res = flush();
+    ::close(data_fd_);
+    ::close(index_fd_);
+  }
+
+  size_t RecordLogWriter::beginRecord() {
+    auto record_offset = buffer_.size();
+    buffer_.resize(record_offset + kReservedLengthSize);
+    return record_offset;
+  }
+
+  outcome::result<uint64_t> RecordLogWriter::finishRecord(
+      size_t record_offset) {
+    auto body_offset = record_offset + kReservedLengthSize;
+    auto body_size = buffer_.size() - body_offset;
+
+    std::array<uint8_t, compact::kMaxCompactLengthSize> length{};
+    auto length_size = compact::encodeCompactLength(body_size, length.data());
+    if (length_size > kReservedLengthSize) {
+      buffer_.insert(buffer_.begin() + body_offset,
+                     length_size - kReservedLengthSize,
+                     0u);
+    } else if (length_size < kReservedLengthSize) {
+      std::memmove(&buffer_[record_offset + length_size],
+                   &buffer_[body_offset],
+                   body_size);
+      buffer_.resize(record_offset + length_size + body_size);
+    }
+    std::memcpy(&buffer_[record_offset], length.data(), length_size);
+
+    auto crc = crc32c::compute(
+        gsl::make_span(&buffer_[record_offset], length_size + body_size));
+    buffer_.resize(buffer_.size() + kChecksumSize);
+    putLittleEndian(
+        &buffer_[buffer_.size() - kChecksumSize], crc, kChecksumSize);
+
+    index_buffer_.resize(index_buffer_.size() + kIndexEntrySize);
+    putLittleEndian(&index_buffer_[index_buffer_.size() - kIndexEntrySize],
+                    data_size_ + record_offset,
+                    kIndexEntrySize);
+
+    auto number = records_++;
+    ++unsynced_records_;
+
+    auto commit = options_.group_commit_records != 0
+                  and unsynced_records_ >= options_.group_commit_records;
+    if (commit or buffer_.size() >= options_.buffer_size) {
+      auto flushed = flush();
+      if (not flushed) {
+        // the record is the last buffered one
+        buffer_.resize(record_offset);
+        index_buffer_.resize(index_buffer_.size() - kIndexEntrySize);
+        --records_;
+        --unsynced_records_;
+        return flushed.as_failure();
+      }
+    }
+    if (commit) {
+      OUTCOME_TRY(sync());
+    }
+    return number;
+  }
+
+  outcome::result<void> RecordLogWriter::flush() {
+    // data goes first, so that the index never points to missing records
+    auto written = writeAll(data_fd_, buffer_);
+    if (written) {
+      written = writeAll(index_fd_, index_buffer_);
+    }
+    if (not written) {
+      // the files are left as they were, so that the buffers are written
+      // again as a whole
+      auto indexed = records_ - index_buffer_.size() / kIndexEntrySize;
+      truncate(index_fd_, indexed * kIndexEntrySize);
+      truncate(data_fd_, data_size_);
+      return written;
+    }
+    data_size_ += buffer_.size();
+    buffer_.clear();
+    index_buffer_.clear();
+    return outcome::success();
+  }
+
+  outcome::result<void> RecordLogWriter::sync() {
+    OUTCOME_TRY(flush());
+    if (::fdatasync(data_fd_) != 0 or ::fdatasync(index_fd_) != 0) {
+      return outcome::failure(lastSystemError());
+    }
+    unsynced_records_ = 0;
+    return outcome::success();
+  }
+
+  uint64_t RecordLogWriter::size() const {
+    return records_;
+  }
+
+  outcome::result<RecordLogReader> RecordLogReader::open(
+      const std::string &path) {
+    OUTCOME_TRY(data, MappedFile::open(path));
+    OUTCOME_TRY(index, MappedFile::open(path + ".idx"));
+    return RecordLogReader{std::move(data), std::move(index)};
+  }
+
+  RecordLogReader::RecordLogReader(MappedFile data, MappedFile index)
+      : data_{std::move(data)}, index_{std::move(index)}, offset_{0} {}
+
+  uint64_t RecordLogReader::size() const {
+    return index_.data().size() / kIndexEntrySize;
+  }
+
+  outcome::result<gsl::span<const uint8_t>> RecordLogReader::at(
+      uint64_t n) const {
+    if (n >= size()) {
+      return RecordLogError::INDEX_OUT_OF_RANGE;
+    }
+    auto offset = getLittleEndian(&index_.data()[n * kIndexEntrySize],
+                                  kIndexEntrySize);
+    if (offset >= static_cast<uint64_t>(data_.data().size())) {
+      return RecordLogError::INDEX_CORRUPTED;
+    }
+    OUTCOME_TRY(record, readAt(offset));
+    return record.first;
+  }
+
+  outcome::result<std::optional<gsl::span<const uint8_t>>>
+  RecordLogReader::next() {
+    if (offset_ >= static_cast<uint64_t>(data_.data().size())) {
+      return std::nullopt;
+    }
+    OUTCOME_TRY(record, readAt(offset_));
+    offset_ = record.second;
+    return record.first;
+  }
+
+  void RecordLogReader::rewind() {
+    offset_ = 0;
+  }
+
+  outcome::result<std::pair<gsl::span<const uint8_t>, uint64_t>>
+  RecordLogReader::readAt(uint64_t offset) const {
+    auto data = data_.data().subspan(offset);
+    ScaleDecoderStream s{data};
+    gsl::span<const uint8_t> value;
+    gsl::span<const uint8_t> checksum;
+    try {
+      CompactInteger length;
+      s >> length;
+      if (not s.hasMore(length.convert_to<uint64_t>() + kChecksumSize)) {
+        return DecodeError::NOT_ENOUGH_DATA;
+      }
+      value = s.nextBytes(length.convert_to<ScaleDecoderStream::SizeType>());
+      checksum = s.nextBytes(kChecksumSize);
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    auto framed = data.first(s.currentIndex() - kChecksumSize);
+    if (crc32c::compute(framed)
+        != getLittleEndian(checksum.data(), kChecksumSize)) {
+      return RecordLogError::CHECKSUM_MISMATCH;
+    }
+    return std::make_pair(value, offset + s.currentIndex());
+  }
+
+}  // namespace scale
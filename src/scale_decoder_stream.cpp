@@ -5,6 +5,7 @@
 
 #include "scale/scale_decoder_stream.hpp"
 
+#include <boost/assert.hpp>
 #include <gsl/span>
 
 #include "scale/scale_error.hpp"
@@ -78,7 +79,11 @@ namespace scale {
   }  // namespace
 
   ScaleDecoderStream::ScaleDecoderStream(gsl::span<const uint8_t> span)
-      : span_{span}, current_iterator_{span_.begin()}, current_index_{0} {}
+      : span_{span},
+        current_iterator_{span_.begin()},
+        current_index_{0},
+        intern_table_{nullptr},
+        strict_map_order_{false} {}
 
   std::optional<bool> ScaleDecoderStream::decodeOptionalBool() {
     auto byte = nextByte();
@@ -129,4 +134,20 @@ namespace scale {
     ++current_index_;
     return *current_iterator_++;
   }
+
+  ScaleDecoderStream::ByteSpan ScaleDecoderStream::nextBytes(SizeType n) {
+    if (n < 0 or not hasMore(n)) {
+      raise(DecodeError::NOT_ENOUGH_DATA);
+    }
+    auto bytes = span_.subspan(current_index_, n);
+    current_index_ += n;
+    current_iterator_ += n;
+    return bytes;
+  }
+
+  void ScaleDecoderStream::rollback(Checkpoint checkpoint) {
+    BOOST_ASSERT(checkpoint.index <= span_.size());
+    current_iterator_ = span_.begin() + checkpoint.index;
+    current_index_ = checkpoint.index;
+  }
 }  // namespace scale
@@ -5,12 +5,19 @@
 
 #include "scale/scale_encoder_stream.hpp"
 
+#include <array>
+
 #include "compact_len_utils.hpp"
 #include "scale/scale_error.hpp"
 #include "scale/types.hpp"
 
 namespace scale {
   namespace {
+    // lengths of collections from 2^14 up to 2^30 items take 4 bytes, so
+    // large collections are not moved when their length is patched, while
+    // shorter ones are moved back once within the allocated storage
+    constexpr size_t kReservedCollectionLengthSize = 4;
+
     // must not use these functions outside encodeInteger
     void encodeFirstCategory(uint8_t value, ScaleEncoderStream &out) {
       // only values from [0, kMinUint16) can be put here
@@ -106,30 +113,151 @@ namespace scale {
   }  // namespace
 
   ScaleEncoderStream::ScaleEncoderStream()
-      : drop_data_{false}, bytes_written_{0} {}
+      : drop_data_{false},
+        bytes_written_{0},
+        sink_{nullptr},
+        buffer_size_{0} {}
 
   ScaleEncoderStream::ScaleEncoderStream(bool drop_data)
-      : drop_data_{drop_data}, bytes_written_{0} {}
+      : drop_data_{drop_data},
+        bytes_written_{0},
+        sink_{nullptr},
+        buffer_size_{0} {}
+
+  ScaleEncoderStream::ScaleEncoderStream(EncoderSink &sink, size_t buffer_size)
+      : drop_data_{false},
+        bytes_written_{0},
+        sink_{&sink},
+        buffer_size_{buffer_size} {
+    stream_.reserve(buffer_size_);
+  }
 
   ByteArray ScaleEncoderStream::to_vector() const {
-    ByteArray buffer(stream_.size(), 0u);
-    for (auto &&[it, dest] = std::pair(stream_.begin(), buffer.begin());
-         it != stream_.end();
-         ++it, ++dest) {
-      *dest = *it;
-    }
-    return buffer;
+    return stream_;
   }
 
   size_t ScaleEncoderStream::size() const {
     return bytes_written_;
   }
 
+  void ScaleEncoderStream::flush() {
+    if (sink_ == nullptr or stream_.empty()) {
+      return;
+    }
+    sink_->write(stream_);
+    stream_.clear();
+  }
+
+  void ScaleEncoderStream::reset() {
+    stream_.clear();
+    bytes_written_ = 0;
+  }
+
+  size_t ScaleEncoderStream::capacity() const {
+    return stream_.capacity();
+  }
+
+  void ScaleEncoderStream::swapBuffer(std::vector<uint8_t> &storage) {
+    stream_.swap(storage);
+    bytes_written_ = stream_.size();
+  }
+
+  void ScaleEncoderStream::expectSize(size_t n) const {
+    if (n > size_limit_ - bytes_written_) {
+      raise(EncodeError::SIZE_LIMIT_EXCEEDED);
+    }
+  }
+
+  void ScaleEncoderStream::expectCollectionSize(const CompactInteger &size,
+                                                size_t element_size) const {
+    if (size_limit_ == kNoSizeLimit) {
+      return;
+    }
+    if (size * element_size + 1 > size_limit_ - bytes_written_) {
+      raise(EncodeError::SIZE_LIMIT_EXCEEDED);
+    }
+  }
+
   ScaleEncoderStream &ScaleEncoderStream::putByte(uint8_t v) {
+    expectSize(1);
     ++bytes_written_;
+    if (drop_data_) {
+      return *this;
+    }
+    if (sink_ != nullptr and buffer_size_ == 0) {
+      sink_->write(gsl::make_span(&v, 1));
+      return *this;
+    }
+    stream_.push_back(v);
+    if (sink_ != nullptr and stream_.size() >= buffer_size_) {
+      flush();
+    }
+    return *this;
+  }
+
+  ScaleEncoderStream &ScaleEncoderStream::putBytes(
+      gsl::span<const uint8_t> bytes) {
+    return putRange(bytes, false);
+  }
+
+  ScaleEncoderStream &ScaleEncoderStream::putReferencedBytes(
+      gsl::span<const uint8_t> bytes) {
+    return putRange(bytes, true);
+  }
+
+  ScaleEncoderStream &ScaleEncoderStream::putRange(
+      gsl::span<const uint8_t> bytes, bool referenced) {
+    expectSize(bytes.size());
+    bytes_written_ += bytes.size();
+    if (drop_data_ or bytes.empty()) {
+      return *this;
+    }
+    if (sink_ != nullptr and static_cast<size_t>(bytes.size()) >= buffer_size_) {
+      // large ranges go to the sink directly, saving a copy
+      flush();
+      if (referenced) {
+        sink_->reference(bytes);
+      } else {
+        sink_->write(bytes);
+      }
+      return *this;
+    }
+    stream_.insert(stream_.end(), bytes.begin(), bytes.end());
+    if (sink_ != nullptr and stream_.size() >= buffer_size_) {
+      flush();
+    }
+    return *this;
+  }
+
+  size_t ScaleEncoderStream::reserveCollectionLength() {
+    auto position = stream_.size();
     if (not drop_data_) {
-      stream_.push_back(v);
+      stream_.resize(position + kReservedCollectionLengthSize);
+    }
+    return position;
+  }
+
+  ScaleEncoderStream &ScaleEncoderStream::patchCollectionLength(
+      size_t position, size_t length) {
+    std::array<uint8_t, compact::kMaxCompactLengthSize> encoded{};
+    auto size = compact::encodeCompactLength(length, encoded.data());
+    expectSize(size);
+    bytes_written_ += size;
+    if (drop_data_) {
+      return *this;
+    }
+    auto items_position = position + kReservedCollectionLengthSize;
+    if (size > kReservedCollectionLengthSize) {
+      stream_.insert(stream_.begin() + items_position,
+                     size - kReservedCollectionLengthSize,
+                     0u);
+    } else if (size < kReservedCollectionLengthSize) {
+      stream_.erase(stream_.begin() + position + size,
+                    stream_.begin() + items_position);
     }
+    std::copy(encoded.begin(),
+              encoded.begin() + size,
+              stream_.begin() + position);
     return *this;
   }
 
@@ -14,6 +14,12 @@ OUTCOME_CPP_DEFINE_CATEGORY_3(scale, EncodeError, e) {
       return "SCALE encode: compact integers too big";
     case EncodeError::DEREF_NULLPOINTER:
       return "SCALE encode: attempt to dereference a nullptr";
+    case EncodeError::SIZE_LIMIT_EXCEEDED:
+      return "SCALE encode: encoded data exceeds the size limit";
+    case EncodeError::COLUMN_SIZE_MISMATCH:
+      return "SCALE encode: columns of a vector differ in size";
+    case EncodeError::UNEXPECTED_ENCODING:
+      return "SCALE encode: encoded data differs from the expected bytes";
   }
   return "unknown EncodeError";
 }
@@ -32,6 +38,12 @@ OUTCOME_CPP_DEFINE_CATEGORY_3(scale, DecodeError, e) {
       return "SCALE decode: wrong type index, cannot decode variant";
     case DecodeError::INVALID_ENUM_VALUE:
       return "SCALE decode: decoded enum value does not belong to the enum";
+    case DecodeError::NON_CANONICAL_ORDER:
+      return "SCALE decode: map keys are not in strictly ascending order";
+    case DecodeError::VALUE_OUT_OF_RANGE:
+      return "SCALE decode: compact value does not fit the target type";
+    case DecodeError::TOO_DEEP_NESTING:
+      return "SCALE decode: values are nested too deep";
   }
   return "unknown SCALE DecodeError";
 }
@@ -0,0 +1,58 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/scatter_gather_sink.hpp"
+
+namespace scale {
+
+  void ScatterGatherSink::write(gsl::span<const uint8_t> bytes) {
+    if (bytes.empty()) {
+      return;
+    }
+    // extend the last segment if it ends where the new data is put
+    if (segments_.empty() or segments_.back().external != nullptr) {
+      segments_.push_back({nullptr, storage_.size(), 0});
+    }
+    storage_.insert(storage_.end(), bytes.begin(), bytes.end());
+    segments_.back().size += bytes.size();
+    size_ += bytes.size();
+  }
+
+  void ScatterGatherSink::reference(gsl::span<const uint8_t> bytes) {
+    if (bytes.empty()) {
+      return;
+    }
+    segments_.push_back(
+        {bytes.data(), 0, static_cast<size_t>(bytes.size())});
+    size_ += bytes.size();
+  }
+
+  std::vector<iovec> ScatterGatherSink::iovecs() const {
+    std::vector<iovec> result;
+    result.reserve(segments_.size());
+    for (const auto &segment : segments_) {
+      const uint8_t *base = segment.external;
+      if (base == nullptr) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        base = storage_.data() + segment.offset;
+      }
+      // iovec is a C structure with non-const base pointer
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      result.push_back({const_cast<uint8_t *>(base), segment.size});
+    }
+    return result;
+  }
+
+  size_t ScatterGatherSink::size() const {
+    return size_;
+  }
+
+  void ScatterGatherSink::clear() {
+    storage_.clear();
+    segments_.clear();
+    size_ = 0;
+  }
+
+}  // namespace scale
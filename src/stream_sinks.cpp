@@ -0,0 +1,46 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/stream_sinks.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+#include "scale/outcome/outcome_throw.hpp"
+
+namespace scale {
+
+  void FileDescriptorSink::write(gsl::span<const uint8_t> bytes) {
+    auto *data = bytes.data();
+    auto left = static_cast<size_t>(bytes.size());
+    while (left > 0) {
+      auto res = ::write(fd_, data, left);
+      if (res < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        raise(std::error_code{errno, std::generic_category()});
+      }
+      if (res == 0) {
+        // nothing is written and no error is reported, retrying would loop
+        raise(std::make_error_code(std::errc::io_error));
+      }
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      data += res;
+      left -= static_cast<size_t>(res);
+    }
+  }
+
+  void OstreamSink::write(gsl::span<const uint8_t> bytes) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    out_.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    if (not out_) {
+      raise(std::make_error_code(std::io_errc::stream));
+    }
+  }
+
+}  // namespace scale
@@ -0,0 +1,133 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define ZLIB_CONST
+#include <zlib.h>
+
+#include <array>
+#include <limits>
+
+#include <scale/outcome/outcome_throw.hpp>
+#include "scale/compression.hpp"
+
+namespace scale {
+
+  namespace {
+    // zlib takes sizes as unsigned int
+    constexpr size_t kMaxZlibSize = std::numeric_limits<uInt>::max();
+
+    [[noreturn]] void raiseInitError(int ret) {
+      if (ret == Z_MEM_ERROR) {
+        throw std::bad_alloc{};
+      }
+      throw std::system_error{
+          std::make_error_code(std::errc::invalid_argument)};
+    }
+
+    class ZlibCompressor final : public Compressor {
+     public:
+      explicit ZlibCompressor(int level) : stream_{} {
+        if (auto ret = deflateInit(&stream_, level); ret != Z_OK) {
+          raiseInitError(ret);
+        }
+      }
+
+      ZlibCompressor(const ZlibCompressor &) = delete;
+      ZlibCompressor &operator=(const ZlibCompressor &) = delete;
+
+      ~ZlibCompressor() override {
+        deflateEnd(&stream_);
+      }
+
+      void compress(gsl::span<const uint8_t> input,
+                    bool finish,
+                    EncoderSink &out) override {
+        do {
+          auto size = std::min<size_t>(input.size(), kMaxZlibSize);
+          auto last = static_cast<size_t>(input.size()) == size;
+          stream_.next_in = input.data();
+          stream_.avail_in = static_cast<uInt>(size);
+          auto flush = finish and last ? Z_FINISH : Z_NO_FLUSH;
+          // deflate until the output buffer is not filled up, so all the
+          // input is consumed and, when finishing, the stream is completed
+          int ret = Z_OK;
+          do {
+            stream_.next_out = buffer_.data();
+            stream_.avail_out = buffer_.size();
+            ret = deflate(&stream_, flush);
+            // no progress is not an error, as the output buffer was not full
+            if (ret != Z_OK and ret != Z_STREAM_END and ret != Z_BUF_ERROR) {
+              raise(CompressionError::COMPRESSION_FAILED);
+            }
+            auto produced = buffer_.size() - stream_.avail_out;
+            if (produced != 0) {
+              out.write(gsl::make_span(buffer_.data(), produced));
+            }
+          } while (stream_.avail_out == 0);
+          if (flush == Z_FINISH and ret != Z_STREAM_END) {
+            raise(CompressionError::COMPRESSION_FAILED);
+          }
+          input = input.subspan(size);
+        } while (not input.empty());
+      }
+
+     private:
+      z_stream stream_;
+      std::array<uint8_t, 1u << 14u> buffer_{};
+    };
+
+    class ZlibDecompressor final : public Decompressor {
+     public:
+      ZlibDecompressor() : stream_{} {
+        if (auto ret = inflateInit(&stream_); ret != Z_OK) {
+          raiseInitError(ret);
+        }
+      }
+
+      ZlibDecompressor(const ZlibDecompressor &) = delete;
+      ZlibDecompressor &operator=(const ZlibDecompressor &) = delete;
+
+      ~ZlibDecompressor() override {
+        inflateEnd(&stream_);
+      }
+
+      bool decompress(gsl::span<const uint8_t> &input,
+                      gsl::span<uint8_t> &output) override {
+        auto input_size = std::min<size_t>(input.size(), kMaxZlibSize);
+        auto output_size = std::min<size_t>(output.size(), kMaxZlibSize);
+        stream_.next_in = input.data();
+        stream_.avail_in = static_cast<uInt>(input_size);
+        stream_.next_out = output.data();
+        stream_.avail_out = static_cast<uInt>(output_size);
+        auto ret = inflate(&stream_, Z_NO_FLUSH);
+        input = input.subspan(input_size - stream_.avail_in);
+        output = output.subspan(output_size - stream_.avail_out);
+        switch (ret) {
+          case Z_STREAM_END:
+            return true;
+          case Z_OK:
+          case Z_BUF_ERROR:
+            return false;
+          case Z_MEM_ERROR:
+            throw std::bad_alloc{};
+          default:
+            raise(CompressionError::CORRUPTED_DATA);
+        }
+      }
+
+     private:
+      z_stream stream_;
+    };
+  }  // namespace
+
+  std::unique_ptr<Compressor> ZlibCodec::compressor() const {
+    return std::make_unique<ZlibCompressor>(level_);
+  }
+
+  std::unique_ptr<Decompressor> ZlibCodec::decompressor() const {
+    return std::make_unique<ZlibDecompressor>();
+  }
+
+}  // namespace scale
@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/bit_vec.hpp"
+#include "scale/scale.hpp"
+#include "scale/scatter_gather_sink.hpp"
+#include "util/outcome.hpp"
+
+using scale::BitVec;
+using scale::BitVecMsb0;
+using scale::ByteArray;
+using scale::DecodeError;
+
+/**
+ * @given bit vectors of 10 bits
+ * @when they are encoded with Lsb0 and Msb0 orders
+ * @then bits are packed into 2 bytes after compact length in the given order
+ * and decoded back
+ */
+TEST(BitVec, EncodeDecode) {
+  std::initializer_list<bool> bits{1, 1, 0, 1, 0, 0, 0, 0, 0, 1};
+
+  EXPECT_OUTCOME_TRUE(lsb, scale::encode(BitVec{bits}));
+  ASSERT_EQ(lsb, (ByteArray{10 << 2, 0b00001011, 0b00000010}));
+  EXPECT_OUTCOME_TRUE(lsb_decoded, scale::decode<BitVec>(lsb));
+  ASSERT_EQ(lsb_decoded, BitVec{bits});
+
+  EXPECT_OUTCOME_TRUE(msb, scale::encode(BitVecMsb0{bits}));
+  ASSERT_EQ(msb, (ByteArray{10 << 2, 0b11010000, 0b01000000}));
+  EXPECT_OUTCOME_TRUE(msb_decoded, scale::decode<BitVecMsb0>(msb));
+  ASSERT_EQ(msb_decoded, BitVecMsb0{bits});
+
+  EXPECT_OUTCOME_TRUE(empty, scale::encode(BitVec{}));
+  ASSERT_EQ(empty, ByteArray{0});
+
+  EXPECT_OUTCOME_FALSE(err, scale::decode<BitVec>(ByteArray{10 << 2, 0xff}));
+  ASSERT_EQ(err, DecodeError::NOT_ENOUGH_DATA);
+}
+
+/**
+ * @given bit vectors longer than a word
+ * @when they are encoded and decoded
+ * @then they are restored, unused bits of the last byte are ignored
+ */
+TEST(BitVec, MultipleWords) {
+  BitVec v(150);
+  for (size_t i = 0; i < v.size(); i += 7) {
+    v.set(i);
+  }
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(v));
+  ASSERT_EQ(encoded.size(), 2 + 19);
+  encoded.back() |= 0x80u;
+  EXPECT_OUTCOME_TRUE(decoded, scale::decode<BitVec>(encoded));
+  ASSERT_EQ(decoded, v);
+}
+
+/**
+ * @given bit vector of several words
+ * @when it is encoded to a scatter-gather sink through a small stream buffer
+ * @then gathered data equals regular encoding result
+ */
+TEST(BitVec, ScatterGatherSink) {
+  BitVec v(128);
+  for (size_t i = 0; i < v.size(); ++i) {
+    v.set(i);
+  }
+  scale::ScatterGatherSink sink;
+  scale::ScaleEncoderStream s{sink, 8};
+  s << v << uint8_t{0};
+  s.flush();
+
+  ByteArray gathered;
+  for (const auto &iov : sink.iovecs()) {
+    auto *base = static_cast<const uint8_t *>(iov.iov_base);
+    gathered.insert(gathered.end(), base, base + iov.iov_len);
+  }
+  EXPECT_OUTCOME_TRUE(expected, scale::encode(v, uint8_t{0}));
+  ASSERT_EQ(gathered, expected);
+}
+
+/**
+ * @given bit vectors
+ * @when word-level operations are applied
+ * @then results match bit-by-bit expectations
+ */
+TEST(BitVec, Operations) {
+  BitVec a(200);
+  BitVec b(130);
+  a.set(3);
+  a.set(64);
+  a.set(150);
+  b.set(64);
+  b.set(100);
+
+  ASSERT_EQ(a.count(), 3);
+  ASSERT_EQ(a.findFirst(), 3);
+  ASSERT_EQ(a.findNext(3), 64);
+  ASSERT_EQ(a.findNext(64), 150);
+  ASSERT_EQ(a.findNext(150), BitVec::npos);
+  ASSERT_EQ(BitVec(70).findFirst(), BitVec::npos);
+
+  auto conj = a & b;
+  ASSERT_EQ(conj.size(), 200);
+  ASSERT_EQ(conj.count(), 1);
+  ASSERT_TRUE(conj[64]);
+
+  auto disj = a | b;
+  ASSERT_EQ(disj.count(), 4);
+  ASSERT_TRUE(disj[100]);
+
+  auto x = a ^ b;
+  ASSERT_EQ(x.count(), 3);
+  ASSERT_FALSE(x[64]);
+
+  BitVec c(5, true);
+  c.resize(70, true);
+  ASSERT_EQ(c.count(), 70);
+  c.resize(66);
+  ASSERT_EQ(c.count(), 66);
+  c.push_back(false);
+  ASSERT_EQ(c.size(), 67);
+  ASSERT_EQ(c.count(), 66);
+  ASSERT_TRUE(BitVec(10).none());
+}
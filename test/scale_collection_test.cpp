@@ -5,11 +5,17 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
+#include <boost/container/flat_map.hpp>
+#include <boost/iterator/filter_iterator.hpp>
+
 #include "scale/scale.hpp"
 #include "util/outcome.hpp"
 
 using scale::ByteArray;
 using scale::CompactInteger;
+using scale::DecodeError;
 using scale::encode;
 using scale::ScaleDecoderStream;
 using scale::ScaleEncoderStream;
@@ -356,3 +362,120 @@ TEST(Scale, encodeMapTest) {
   ASSERT_TRUE(std::equal(
       decoded.begin(), decoded.end(), collection.begin(), collection.end()));
 }
+
+/**
+ * @given maps encoded in ascending key order, unordered and with duplicate
+ * keys
+ * @when they are decoded into ordered, unordered and flat maps in strict and
+ * default mode
+ * @then strict mode rejects non-canonical ones, default mode keeps the first
+ * of duplicate keys
+ */
+TEST(Scale, decodeMapOrder) {
+  using Pairs = std::vector<std::pair<uint32_t, std::string>>;
+  EXPECT_OUTCOME_TRUE(sorted, encode(Pairs{{1, "a"}, {2, "b"}, {5, "c"}}));
+  EXPECT_OUTCOME_TRUE(unsorted, encode(Pairs{{2, "b"}, {1, "a"}, {5, "c"}}));
+  EXPECT_OUTCOME_TRUE(duplicate, encode(Pairs{{1, "a"}, {1, "x"}, {5, "c"}}));
+  std::map<uint32_t, std::string> expected{{1, "a"}, {2, "b"}, {5, "c"}};
+
+  auto check = [&](auto map) {
+    using Map = decltype(map);
+    for (auto &bytes : {sorted, unsorted}) {
+      ScaleDecoderStream s{bytes};
+      s >> map;
+      ASSERT_EQ(decltype(expected)(map.begin(), map.end()), expected);
+    }
+    ScaleDecoderStream s{duplicate};
+    s >> map;
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_EQ(map.at(1), "a");
+
+    ScaleDecoderStream strict{sorted};
+    strict.setStrictMapOrder(true);
+    strict >> map;
+    ASSERT_EQ(map.size(), 3);
+    for (auto &bytes : {unsorted, duplicate}) {
+      ScaleDecoderStream strict{bytes};
+      strict.setStrictMapOrder(true);
+      try {
+        strict >> map;
+        FAIL() << typeid(Map).name();
+      } catch (std::system_error &e) {
+        ASSERT_EQ(e.code(), DecodeError::NON_CANONICAL_ORDER);
+      }
+    }
+  };
+  check(std::map<uint32_t, std::string>{});
+  check(std::unordered_map<uint32_t, std::string>{});
+  check(boost::container::flat_map<uint32_t, std::string>{});
+}
+
+/**
+ * @given ranges of various lengths, which sizes are not known beforehand
+ * @when they are encoded as lazy collections
+ * @then the result equals encoding of materialized collections of any length
+ * prefix size
+ */
+TEST(Scale, encodeLazyCollection) {
+  for (uint32_t n : {0u, 10u, 63u, 64u, 20000u}) {
+    std::vector<uint32_t> values(2 * n);
+    std::iota(values.begin(), values.end(), 0u);
+    std::vector<uint32_t> even;
+    std::copy_if(values.begin(),
+                 values.end(),
+                 std::back_inserter(even),
+                 [](uint32_t v) { return v % 2 == 0; });
+
+    auto is_even = [](uint32_t v) { return v % 2 == 0; };
+    auto begin =
+        boost::make_filter_iterator(is_even, values.begin(), values.end());
+    auto end =
+        boost::make_filter_iterator(is_even, values.end(), values.end());
+
+    ScaleEncoderStream s;
+    s << uint8_t{0xFF};
+    s.encodeLazyCollection(begin, end);
+    s << uint8_t{0xEE};
+    ASSERT_EQ(s.to_vector(),
+              encode(uint8_t{0xFF}, even, uint8_t{0xEE}).value());
+    ASSERT_EQ(s.size(), s.to_vector().size());
+
+    ScaleEncoderStream counter{true};
+    counter.encodeLazyCollection(begin, end);
+    ASSERT_EQ(counter.size(), encode(even).value().size());
+  }
+}
+
+/**
+ * @given generator of strings
+ * @when it is encoded as a collection to a sink
+ * @then the result equals encoding of the materialized collection
+ */
+TEST(Scale, encodeGeneratedCollection) {
+  std::vector<std::string> expected{"a", "bb", "ccc"};
+  size_t i = 0;
+  auto generate = [&]() -> std::optional<std::string> {
+    if (i == expected.size()) {
+      return std::nullopt;
+    }
+    return expected[i++];
+  };
+
+  struct Sink : scale::EncoderSink {
+    void write(gsl::span<const uint8_t> bytes) override {
+      data.insert(data.end(), bytes.begin(), bytes.end());
+    }
+    ByteArray data;
+  } sink;
+  ScaleEncoderStream s{sink, 2};
+  s.encodeGeneratedCollection(generate);
+  s.flush();
+  ASSERT_EQ(sink.data, encode(expected).value());
+
+  // items held until they are counted are subject to the size limit
+  i = 0;
+  ScaleEncoderStream limited{sink, 2};
+  limited.setSizeLimit(3);
+  ASSERT_THROW(limited.encodeGeneratedCollection(generate), std::system_error);
+  ASSERT_LT(i, expected.size());
+}
@@ -0,0 +1,168 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/columns.hpp"
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::Columns;
+using scale::DecodeError;
+
+using AccountId = std::array<uint8_t, 32>;
+
+struct Transfer {
+  SCALE_TIE(4);
+  AccountId from;
+  uint64_t amount;
+  bool keep_alive;
+  int16_t fee;
+};
+
+struct Event {
+  SCALE_TIE(3);
+  uint32_t index;
+  std::string name;
+  std::optional<uint64_t> amount;
+};
+
+/**
+ * @given encoded vector of structs of static size
+ * @when it is decoded as columns
+ * @then each column holds the field of every element
+ */
+TEST(Columns, StaticSizeElements) {
+  std::vector<Transfer> transfers;
+  for (uint8_t i = 0; i < 20; ++i) {
+    AccountId from{};
+    from.fill(i);
+    transfers.push_back(
+        Transfer{from, uint64_t{i} << 40u, i % 3 == 0, int16_t(-i)});
+  }
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(transfers));
+  EXPECT_OUTCOME_TRUE(columns, scale::decode<Columns<Transfer>>(encoded));
+
+  ASSERT_EQ(columns.size(), transfers.size());
+  for (size_t i = 0; i < transfers.size(); ++i) {
+    ASSERT_EQ(columns.column<0>()[i], transfers[i].from);
+    ASSERT_EQ(columns.column<1>()[i], transfers[i].amount);
+    ASSERT_EQ(columns.column<2>()[i], transfers[i].keep_alive);
+    ASSERT_EQ(columns.column<3>()[i], transfers[i].fee);
+  }
+
+  // invalid bool
+  encoded[1 + 32 + 8] = 2;
+  EXPECT_OUTCOME_FALSE(e, scale::decode<Columns<Transfer>>(encoded));
+  ASSERT_EQ(e, DecodeError::UNEXPECTED_VALUE);
+}
+
+/**
+ * @given encoded vector of pairs and of structs with fields of dynamic size
+ * @when they are decoded as columns
+ * @then each column holds the field of every element
+ */
+TEST(Columns, DynamicSizeElements) {
+  std::vector<Event> events;
+  for (uint32_t i = 0; i < 20; ++i) {
+    events.push_back(Event{i,
+                           std::string(i, 'e'),
+                           i % 2 == 0 ? std::nullopt
+                                      : std::optional<uint64_t>{i * 7}});
+  }
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(events));
+  EXPECT_OUTCOME_TRUE(columns, scale::decode<Columns<Event>>(encoded));
+  ASSERT_EQ(columns.size(), events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    ASSERT_EQ(columns.column<0>()[i], events[i].index);
+    ASSERT_EQ(columns.column<1>()[i], events[i].name);
+    ASSERT_EQ(columns.column<2>()[i], events[i].amount);
+  }
+
+  std::vector<std::pair<uint32_t, ByteArray>> pairs{{1, {2}}, {3, {4, 5}}};
+  EXPECT_OUTCOME_TRUE(encoded_pairs, scale::encode(pairs));
+  using Pair = std::pair<uint32_t, ByteArray>;
+  EXPECT_OUTCOME_TRUE(pair_columns,
+                      scale::decode<Columns<Pair>>(encoded_pairs));
+  ASSERT_EQ(pair_columns.column<0>(), (std::vector<uint32_t>{1, 3}));
+  ASSERT_EQ(pair_columns.column<1>(), (std::vector<ByteArray>{{2}, {4, 5}}));
+
+  using scale::Compact;
+  using Entry = std::pair<Compact<uint32_t>, ByteArray>;
+  std::vector<Entry> entries{{{300}, {1, 2}}, {{70000}, {3}}, {{1}, {}}};
+  EXPECT_OUTCOME_TRUE(encoded_entries, scale::encode(entries));
+  EXPECT_OUTCOME_TRUE(entry_columns,
+                      scale::decode<Columns<Entry>>(encoded_entries));
+  ASSERT_EQ(entry_columns.column<0>(),
+            (std::vector<Compact<uint32_t>>{{300}, {70000}, {1}}));
+  ASSERT_EQ(entry_columns.column<1>(),
+            (std::vector<ByteArray>{{1, 2}, {3}, {}}));
+}
+
+/**
+ * @given truncated encoded vectors
+ * @when they are decoded as columns
+ * @then NOT_ENOUGH_DATA error is returned
+ */
+TEST(Columns, Truncated) {
+  EXPECT_OUTCOME_TRUE(transfers, scale::encode(std::vector<Transfer>(3)));
+  transfers.pop_back();
+  EXPECT_OUTCOME_FALSE(e, scale::decode<Columns<Transfer>>(transfers));
+  ASSERT_EQ(e, DecodeError::NOT_ENOUGH_DATA);
+
+  EXPECT_OUTCOME_TRUE(events, scale::encode(std::vector<Event>(3)));
+  events.pop_back();
+  EXPECT_OUTCOME_FALSE(events_error, scale::decode<Columns<Event>>(events));
+  ASSERT_EQ(events_error, DecodeError::NOT_ENOUGH_DATA);
+}
+
+/**
+ * @given columns of fields of structs of static and dynamic size
+ * @when they are encoded as vectors of the structs
+ * @then the result is equal to encoded vectors of the structs
+ */
+TEST(Columns, Encode) {
+  std::vector<Transfer> transfers;
+  std::vector<AccountId> from;
+  std::vector<uint64_t> amounts;
+  std::vector<bool> keep_alive;
+  std::vector<int16_t> fees;
+  for (uint8_t i = 0; i < 20; ++i) {
+    AccountId account{};
+    account.fill(i);
+    transfers.push_back(
+        Transfer{account, uint64_t{i} << 40u, i % 3 == 0, int16_t(-i)});
+    from.push_back(account);
+    amounts.push_back(transfers.back().amount);
+    keep_alive.push_back(transfers.back().keep_alive);
+    fees.push_back(transfers.back().fee);
+  }
+  EXPECT_OUTCOME_TRUE(expected, scale::encode(transfers));
+  scale::ScaleEncoderStream s;
+  scale::encodeColumns<Transfer>(s, from, amounts, keep_alive, fees);
+  ASSERT_EQ(s.to_vector(), expected);
+
+  EXPECT_OUTCOME_TRUE(columns, scale::decode<Columns<Transfer>>(expected));
+  EXPECT_OUTCOME_TRUE(reencoded, scale::encode(columns));
+  ASSERT_EQ(reencoded, expected);
+
+  std::vector<uint32_t> indices{1, 2};
+  std::vector<std::string> names{"a", "bc"};
+  std::vector<std::optional<uint64_t>> event_amounts{std::nullopt, 5};
+  EXPECT_OUTCOME_TRUE(expected_events,
+                      scale::encode(std::vector<Event>{
+                          {1, "a", std::nullopt}, {2, "bc", 5}}));
+  scale::ScaleEncoderStream events;
+  scale::encodeColumns<Event>(
+      events, gsl::make_span(indices), names, event_amounts);
+  ASSERT_EQ(events.to_vector(), expected_events);
+
+  names.pop_back();
+  scale::ScaleEncoderStream mismatch;
+  EXPECT_THROW(
+      scale::encodeColumns<Event>(mismatch, indices, names, event_amounts),
+      std::system_error);
+}
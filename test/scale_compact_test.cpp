@@ -162,3 +162,179 @@ TEST(Scale, compactDecodeBigIntegerError) {
   ASSERT_EQ(err.value(),
             static_cast<int>(scale::DecodeError::NOT_ENOUGH_DATA));
 }
+
+namespace {
+  // values of all modes, in runs of the same mode and mixed
+  std::vector<uint64_t> makeCompactValues() {
+    std::vector<uint64_t> values;
+    for (uint64_t i = 0; i < 40; ++i) {
+      values.push_back(i);
+    }
+    for (uint64_t i = 0; i < 20; ++i) {
+      values.push_back(64 + i * 500);
+    }
+    for (uint64_t i = 0; i < 10; ++i) {
+      values.push_back((1u << 14u) + i * 1000000);
+    }
+    for (uint64_t i = 0; i < 100; ++i) {
+      values.push_back(std::vector<uint64_t>{
+          1, 100, 1u << 20u, (1ull << 30u) + i, 1ull << 40u}[i % 5]);
+    }
+    return values;
+  }
+}  // namespace
+
+/**
+ * @given compact values of all modes
+ * @when they are decoded as vector of Compact<T> and in batches with and
+ * without SIMD
+ * @then decoded values match the encoded ones
+ */
+TEST(ScaleCompactTest, BatchDecode) {
+  using scale::Compact;
+  auto values = makeCompactValues();
+  std::vector<Compact<uint64_t>> compacts;
+  for (auto value : values) {
+    compacts.push_back(Compact<uint64_t>{value});
+  }
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(compacts));
+
+  ScaleEncoderStream s;
+  s << CompactInteger{values.size()};
+  for (auto value : values) {
+    s << CompactInteger{value};
+  }
+  ASSERT_EQ(encoded, s.to_vector());
+
+  EXPECT_OUTCOME_TRUE(decoded, decode<std::vector<Compact<uint64_t>>>(encoded));
+  ASSERT_EQ(decoded, compacts);
+
+  // skip the length
+  auto items = gsl::make_span(encoded).subspan(2);
+  std::vector<uint64_t> simd(values.size());
+  auto result = scale::detail::decodeCompactBatch(items, gsl::make_span(simd));
+  ASSERT_FALSE(result.error);
+  ASSERT_EQ(result.decoded, values.size());
+  ASSERT_EQ(result.consumed, items.size());
+  ASSERT_EQ(simd, values);
+
+  std::vector<uint64_t> scalar(values.size());
+  result =
+      scale::detail::decodeCompactBatchScalar(items, gsl::make_span(scalar));
+  ASSERT_EQ(result.consumed, items.size());
+  ASSERT_EQ(scalar, values);
+}
+
+/**
+ * @given compact values, some of which do not fit u32 or are truncated
+ * @when they are decoded in a batch
+ * @then the values before the failing one are decoded @and the stream is
+ * left at the failing value
+ */
+TEST(ScaleCompactTest, BatchDecodeErrors) {
+  using scale::Compact;
+  std::vector<Compact<uint64_t>> values(40, Compact<uint64_t>{1});
+  values[35].value = 1ull << 32u;
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(values));
+
+  EXPECT_OUTCOME_FALSE(e1, decode<std::vector<Compact<uint32_t>>>(encoded));
+  ASSERT_EQ(e1, scale::DecodeError::VALUE_OUT_OF_RANGE);
+
+  ScaleDecoderStream s{gsl::make_span(encoded).subspan(1)};
+  std::vector<uint32_t> out(40);
+  EXPECT_THROW(s.decodeCompacts(gsl::make_span(out)), std::system_error);
+  ASSERT_EQ(s.currentIndex(), 35);
+  ASSERT_EQ(out[34], 1);
+
+  encoded.resize(encoded.size() - 1);
+  EXPECT_OUTCOME_FALSE(e2, decode<std::vector<Compact<uint64_t>>>(encoded));
+  ASSERT_EQ(e2, scale::DecodeError::NOT_ENOUGH_DATA);
+
+  // length exceeding the data is rejected before allocation
+  EXPECT_OUTCOME_FALSE(
+      e3, decode<std::vector<Compact<uint32_t>>>(ByteArray{0xfe, 0xff, 0, 0}));
+  ASSERT_EQ(e3, scale::DecodeError::NOT_ENOUGH_DATA);
+
+  EXPECT_OUTCOME_FALSE(e4, decode<Compact<uint8_t>>(ByteArray{0x01, 0x04}));
+  ASSERT_EQ(e4, scale::DecodeError::VALUE_OUT_OF_RANGE);
+  EXPECT_OUTCOME_TRUE(v, decode<Compact<uint8_t>>(ByteArray{0xfd, 0x03}));
+  ASSERT_EQ(v.value, 255);
+}
+
+/**
+ * @given u32 and u64 values around the limits of compact modes
+ * @when they are encoded in a batch
+ * @then the result equals encoding of them one by one
+ */
+TEST(ScaleCompactTest, BatchEncode) {
+  using scale::Compact;
+  std::vector<uint64_t> limits{0,
+                               63,
+                               64,
+                               (1u << 14u) - 1,
+                               1u << 14u,
+                               (1u << 30u) - 1,
+                               1u << 30u,
+                               std::numeric_limits<uint32_t>::max()};
+  std::vector<Compact<uint32_t>> small;
+  std::vector<Compact<uint64_t>> large;
+  ScaleEncoderStream small_expected;
+  ScaleEncoderStream large_expected;
+  for (size_t i = 0; i < 101; ++i) {
+    auto value = limits[(i * 7) % limits.size()];
+    small.push_back(Compact<uint32_t>{static_cast<uint32_t>(value)});
+    small_expected << CompactInteger{value};
+    uint64_t large_value = i % 3 == 0 ? (value << 32u) | value : value;
+    large.push_back(Compact<uint64_t>{large_value});
+    large_expected << CompactInteger{large_value};
+  }
+  large.push_back(Compact<uint64_t>{std::numeric_limits<uint64_t>::max()});
+  large_expected << CompactInteger{std::numeric_limits<uint64_t>::max()};
+
+  ScaleEncoderStream s;
+  s.encodeCompacts(gsl::make_span(small));
+  ASSERT_EQ(s.to_vector(), small_expected.to_vector());
+  ASSERT_EQ(s.size(), small_expected.size());
+
+  ScaleEncoderStream counter{true};
+  counter.encodeCompacts(gsl::make_span(large));
+  ASSERT_EQ(counter.size(), large_expected.size());
+
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(large));
+  EXPECT_OUTCOME_TRUE(decoded, decode<std::vector<Compact<uint64_t>>>(encoded));
+  ASSERT_EQ(decoded, large);
+}
+
+/**
+ * @given encoded values following Compact values and batch-decoded vectors
+ * of them
+ * @when they are decoded
+ * @then the following values are decoded from their own bytes
+ */
+TEST(ScaleCompactTest, DecodeValuesAfterCompacts) {
+  using scale::Compact;
+  EXPECT_OUTCOME_TRUE(value,
+                      (decode<std::pair<Compact<uint32_t>, uint8_t>>(
+                          ByteArray{0x04, 0x07})));
+  ASSERT_EQ(value.first.value, 1);
+  ASSERT_EQ(value.second, 7);
+
+  std::vector<Compact<uint32_t>> compacts{{1}, {2}, {3}};
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(compacts, uint8_t{9}));
+  EXPECT_OUTCOME_TRUE(
+      decoded,
+      (decode<std::pair<std::vector<Compact<uint32_t>>, uint8_t>>(encoded)));
+  ASSERT_EQ(decoded.first, compacts);
+  ASSERT_EQ(decoded.second, 9);
+
+  using Entry = std::pair<Compact<uint32_t>, ByteArray>;
+  std::vector<Entry> entries{{{300}, {1, 2}}, {{70000}, {3}}};
+  EXPECT_OUTCOME_TRUE(encoded_entries, scale::encode(entries));
+  EXPECT_OUTCOME_TRUE(decoded_entries,
+                      decode<std::vector<Entry>>(encoded_entries));
+  ASSERT_EQ(decoded_entries, entries);
+
+  scale::ScaleDecoderStream s{encoded_entries};
+  scale::skip<std::vector<Entry>>(s);
+  ASSERT_FALSE(s.hasMore(1));
+}
@@ -0,0 +1,120 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/comparing_sink.hpp"
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::CompactInteger;
+using scale::equals_encoded;
+
+using Value = std::tuple<uint32_t, std::string, ByteArray>;
+
+/**
+ * @given a value and its encoding
+ * @when the value is compared with its encoding
+ * @then they are equal
+ */
+TEST(EqualsEncoded, Equal) {
+  Value value{42, "hello", ByteArray(5000, 1)};
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(value));
+  ASSERT_TRUE(equals_encoded(value, encoded));
+}
+
+/**
+ * @given a value and its encoding with a changed byte, a truncated and an
+ * extended one
+ * @when the value is compared with them
+ * @then they are not equal
+ */
+TEST(EqualsEncoded, Mismatch) {
+  Value value{42, "hello", ByteArray(5000, 1)};
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(value));
+
+  for (auto i : {size_t{0}, size_t{6}, encoded.size() - 1}) {
+    auto changed = encoded;
+    changed[i] ^= 1u;
+    ASSERT_FALSE(equals_encoded(value, changed)) << i;
+  }
+
+  auto truncated = encoded;
+  truncated.pop_back();
+  ASSERT_FALSE(equals_encoded(value, truncated));
+
+  auto extended = encoded;
+  extended.push_back(0);
+  ASSERT_FALSE(equals_encoded(value, extended));
+
+  ASSERT_FALSE(equals_encoded(value, ByteArray{}));
+}
+
+/**
+ * @given a value which cannot be encoded
+ * @when it is compared with some bytes
+ * @then they are not equal
+ */
+TEST(EqualsEncoded, EncodeError) {
+  ASSERT_FALSE(equals_encoded(CompactInteger{-1}, ByteArray{0}));
+}
+
+/**
+ * @given comparing sink written by an unbuffered stream
+ * @when data differing from the expected bytes is encoded
+ * @then the sink reports the mismatch @and the stream buffers nothing
+ */
+TEST(ComparingSink, UnbufferedStream) {
+  ByteArray expected{1, 2, 3, 4};
+  scale::ComparingSink sink{expected};
+  scale::ScaleEncoderStream s{sink, 0};
+  s << uint8_t{1} << uint8_t{2};
+  ASSERT_TRUE(s.to_vector().empty());
+  ASSERT_FALSE(sink.mismatch());
+  ASSERT_FALSE(sink.complete());
+  ASSERT_THROW(s << uint16_t{0}, std::system_error);
+  ASSERT_TRUE(sink.mismatch());
+  ASSERT_FALSE(sink.complete());
+}
+
+namespace {
+  // counts elements put to streams
+  struct Counted {
+    static inline size_t encoded = 0;
+    uint8_t value;
+  };
+
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const Counted &v) {
+    ++Counted::encoded;
+    return s << v.value;
+  }
+}  // namespace
+
+/**
+ * @given a large value and bytes differing from its encoding in the first
+ * byte or shorter than it
+ * @when the value is compared with them
+ * @then they are not equal @and encoding stops before the whole value is
+ * encoded
+ */
+TEST(EqualsEncoded, StopsAtMismatch) {
+  std::vector<Counted> value(10000, Counted{7});
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(value));
+
+  auto changed = encoded;
+  changed[0] ^= 1u;
+  Counted::encoded = 0;
+  ASSERT_FALSE(equals_encoded(value, changed));
+  ASSERT_EQ(Counted::encoded, 0);
+
+  auto truncated = encoded;
+  truncated.resize(100);
+  Counted::encoded = 0;
+  ASSERT_FALSE(equals_encoded(value, truncated));
+  ASSERT_LT(Counted::encoded, 100);
+}
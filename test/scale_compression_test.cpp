@@ -0,0 +1,130 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/compression.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::CompressingSink;
+using scale::CompressionCodec;
+using scale::CompressionError;
+using scale::DecompressingSource;
+using scale::ZlibCodec;
+
+namespace {
+  class VectorSink final : public scale::EncoderSink {
+   public:
+    void write(gsl::span<const uint8_t> bytes) override {
+      data.insert(data.end(), bytes.begin(), bytes.end());
+    }
+
+    ByteArray data;
+  };
+
+  std::vector<std::string> makeValue() {
+    std::vector<std::string> value;
+    for (size_t i = 0; i < 10000; ++i) {
+      value.emplace_back("entry #" + std::to_string(i % 100));
+    }
+    return value;
+  }
+}  // namespace
+
+/**
+ * @given large repetitive value
+ * @when it is encoded into zlib frame and decoded back
+ * @then frame is smaller than the encoded value and the value is restored
+ */
+TEST(Compression, ZlibRoundTrip) {
+  auto value = makeValue();
+  VectorSink sink;
+  EXPECT_OUTCOME_TRUE_1(scale::encodeCompressed(sink, ZlibCodec{}, value));
+  auto encoded = scale::encode(value).value();
+  ASSERT_EQ(sink.data[0], ZlibCodec::kId);
+  ASSERT_LT(sink.data.size() * 5, encoded.size());
+
+  VectorSink frame;
+  EXPECT_OUTCOME_TRUE_1(scale::compressFrame(frame, ZlibCodec{}, encoded));
+  ASSERT_EQ(frame.data, sink.data);
+
+  EXPECT_OUTCOME_TRUE(
+      decoded, scale::decodeCompressed<std::vector<std::string>>(sink.data));
+  ASSERT_EQ(decoded, value);
+
+  // empty data
+  VectorSink empty;
+  EXPECT_OUTCOME_TRUE_1(
+      scale::encodeCompressed(empty, ZlibCodec{}, ByteArray{}));
+  EXPECT_OUTCOME_TRUE(empty_decoded,
+                      scale::decodeCompressed<ByteArray>(empty.data));
+  ASSERT_TRUE(empty_decoded.empty());
+}
+
+/**
+ * @given zlib frame
+ * @when its data is read by small chunks
+ * @then chunks make up the encoded value
+ */
+TEST(Compression, ReadByChunks) {
+  auto encoded = scale::encode(makeValue()).value();
+  VectorSink sink;
+  CompressingSink compressing{sink, ZlibCodec{1}, encoded.size()};
+  scale::ScaleEncoderStream s{compressing, 16};
+  s.putBytes(encoded);
+  s.flush();
+  compressing.finish();
+
+  EXPECT_OUTCOME_TRUE(source, DecompressingSource::open(sink.data));
+  ASSERT_EQ(source.size(), encoded.size());
+  ByteArray data;
+  std::array<uint8_t, 100> chunk{};
+  while (true) {
+    EXPECT_OUTCOME_TRUE(bytes, source.read(chunk));
+    if (bytes.empty()) {
+      break;
+    }
+    data.insert(data.end(), bytes.begin(), bytes.end());
+  }
+  ASSERT_EQ(data, encoded);
+}
+
+/**
+ * @given malformed frames
+ * @when they are decoded
+ * @then corresponding errors are returned
+ */
+TEST(Compression, MalformedFrames) {
+  ByteArray value(1000, 42);
+  VectorSink sink;
+  EXPECT_OUTCOME_TRUE_1(scale::encodeCompressed(sink, ZlibCodec{}, value));
+
+  auto unknown_codec = sink.data;
+  unknown_codec[0] = 0x7f;
+  EXPECT_OUTCOME_FALSE(
+      e1, scale::decodeCompressed<ByteArray>(unknown_codec));
+  ASSERT_EQ(e1, CompressionError::UNKNOWN_CODEC);
+
+  auto truncated = sink.data;
+  truncated.resize(truncated.size() - 4);
+  EXPECT_OUTCOME_FALSE(e2, scale::decodeCompressed<ByteArray>(truncated));
+  ASSERT_EQ(e2, CompressionError::CORRUPTED_DATA);
+
+  auto corrupted = sink.data;
+  corrupted[4] ^= 0xffu;
+  EXPECT_OUTCOME_FALSE_1(scale::decodeCompressed<ByteArray>(corrupted));
+
+  EXPECT_OUTCOME_FALSE(e3, scale::decodeCompressed<ByteArray>(sink.data, 100));
+  ASSERT_EQ(e3, CompressionError::TOO_LARGE);
+
+  // declared size does not match the body
+  VectorSink mismatch;
+  CompressingSink compressing{mismatch, ZlibCodec{}, 3};
+  compressing.write(gsl::make_span(value).first(2));
+  EXPECT_THROW(compressing.finish(), std::system_error);
+  EXPECT_THROW(compressing.write(gsl::make_span(value).first(2)),
+               std::system_error);
+}
@@ -61,3 +61,93 @@ TEST(ScaleConvenienceFuncsTest, EncodeSeveralValidArgTest) {
   ASSERT_EQ(decoded.a, expected_string);
   ASSERT_EQ(decoded.b, expected_int);
 }
+
+/**
+ * @given buffer with enough capacity
+ * @when values are encoded into it
+ * @then the buffer holds the encoded data in its own storage
+ */
+TEST(ScaleConvenienceFuncsTest, EncodeInto) {
+  TestStruct s1{"some_string", 42};
+  EXPECT_OUTCOME_TRUE(expected, encode(s1));
+
+  std::vector<uint8_t> buffer(100, 0xff);
+  const auto *storage = buffer.data();
+  EXPECT_OUTCOME_TRUE_1(scale::encode_into(buffer, s1));
+  ASSERT_EQ(buffer, expected);
+  ASSERT_EQ(buffer.data(), storage);
+
+  EXPECT_OUTCOME_TRUE_1(scale::encode_into(buffer, s1, s1));
+  ASSERT_EQ(buffer.size(), expected.size() * 2);
+  ASSERT_EQ(buffer.data(), storage);
+}
+
+struct Nested {
+  TestStruct inner;
+};
+
+template <class Stream, typename = std::enable_if_t<Stream::is_encoder_stream>>
+Stream &operator<<(Stream &s, const Nested &nested) {
+  return s << encode(nested.inner).value();
+}
+
+/**
+ * @given value, which encoding encodes another value with scale::encode
+ * @when it is encoded
+ * @then nested encoding takes its own stream from the pool
+ */
+TEST(ScaleConvenienceFuncsTest, NestedEncode) {
+  TestStruct s1{"some_string", 42};
+  EXPECT_OUTCOME_TRUE(inner, encode(s1));
+  EXPECT_OUTCOME_TRUE(encoded, encode(uint8_t{1}, Nested{s1}));
+  EXPECT_OUTCOME_TRUE(expected, encode(uint8_t{1}, inner));
+  ASSERT_EQ(encoded, expected);
+}
+
+/**
+ * @given stream with encoded data
+ * @when it is reset
+ * @then data is dropped @and storage is kept
+ */
+TEST(ScaleConvenienceFuncsTest, ResetKeepsCapacity) {
+  scale::ScaleEncoderStream s;
+  s << std::vector<uint32_t>(1000);
+  auto capacity = s.capacity();
+  s.reset();
+  ASSERT_EQ(s.size(), 0);
+  ASSERT_TRUE(s.to_vector().empty());
+  ASSERT_EQ(s.capacity(), capacity);
+  s << uint8_t{1};
+  ASSERT_EQ(s.to_vector(), std::vector<uint8_t>{1});
+}
+
+/**
+ * @given collections and a size limit
+ * @when they are encoded with the limit
+ * @then those which do not fit fail with SIZE_LIMIT_EXCEEDED @and
+ * collections of static-size elements fail before anything is encoded
+ */
+TEST(ScaleConvenienceFuncsTest, EncodeWithLimit) {
+  std::vector<uint32_t> numbers(100);
+  EXPECT_OUTCOME_FALSE(e1, scale::encode_with_limit(400, numbers));
+  ASSERT_EQ(e1, scale::EncodeError::SIZE_LIMIT_EXCEEDED);
+  EXPECT_OUTCOME_FALSE_1(scale::encode_with_limit(401, numbers));
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode_with_limit(402, numbers));
+  ASSERT_EQ(encoded.size(), 402);
+
+  scale::ScaleEncoderStream s;
+  s.setSizeLimit(10);
+  s << uint8_t{1};
+  EXPECT_THROW(s << numbers, std::system_error);
+  ASSERT_EQ(s.size(), 1);
+  EXPECT_THROW(s << std::string(100, 'a'), std::system_error);
+  ASSERT_EQ(s.size(), 1);
+
+  // fails in the middle of the collection without crossing the limit
+  std::vector<std::string> strings(10, "abc");
+  EXPECT_THROW(s << strings, std::system_error);
+  ASSERT_LE(s.size(), 10);
+
+  // the limit does not stay with pooled streams
+  EXPECT_OUTCOME_TRUE_1(scale::encode(numbers));
+}
@@ -58,3 +58,43 @@ TEST(ScaleDecoderStreamTest, HasMoreTest) {
 
   ASSERT_ANY_THROW(stream.nextByte());
 }
+
+/**
+ * @given stream of a message which may have one of two layouts
+ * @when the first layout fails to decode under a rollback guard
+ * @then the stream returns to the start of the message, the second layout is
+ * decoded and committed
+ */
+TEST(ScaleDecoderStreamTest, CheckpointRollback) {
+  // version byte, then u16 of version 2
+  auto bytes = ByteArray{2, 0x34, 0x12};
+  auto stream = ScaleDecoderStream{bytes};
+  auto start = stream.checkpoint();
+  uint8_t version = 0;
+  stream >> version;
+  ASSERT_EQ(version, 2);
+
+  stream.rollback(start);
+  ASSERT_EQ(stream.currentIndex(), 0);
+  stream >> version;
+
+  // layout of version 1 expects u32
+  try {
+    ScaleDecoderStream::RollbackGuard guard{stream};
+    uint32_t value = 0;
+    stream >> value;
+    guard.commit();
+    FAIL();
+  } catch (std::system_error &) {
+  }
+  ASSERT_EQ(stream.currentIndex(), 1);
+
+  uint16_t value = 0;
+  {
+    ScaleDecoderStream::RollbackGuard guard{stream};
+    stream >> value;
+    guard.commit();
+  }
+  ASSERT_EQ(value, 0x1234);
+  ASSERT_FALSE(stream.hasMore(1));
+}
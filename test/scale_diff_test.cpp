@@ -0,0 +1,117 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/diff.hpp"
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::DiffError;
+using scale::Patch;
+using scale::Splice;
+
+struct State {
+  SCALE_TIE(3);
+  uint64_t version;
+  std::vector<uint32_t> balances;
+  std::map<uint32_t, std::string> names;
+};
+
+namespace {
+  template <class T>
+  Patch checkRoundTrip(const T &old_value, const T &new_value) {
+    auto old_encoded = scale::encode(old_value).value();
+    auto new_encoded = scale::encode(new_value).value();
+    auto patch = scale::diff<T>(old_encoded, new_encoded).value();
+    EXPECT_EQ(scale::patch(old_encoded, patch).value(), new_encoded);
+    return patch;
+  }
+}  // namespace
+
+/**
+ * @given vector of fixed-size elements
+ * @when single element is changed, inserted or removed
+ * @then patch holds only the changed elements and restores the new value
+ */
+TEST(Diff, FixedSizeElements) {
+  std::vector<uint32_t> old_value(1000);
+  for (size_t i = 0; i < old_value.size(); ++i) {
+    old_value[i] = i;
+  }
+
+  auto changed = old_value;
+  changed[500] = 7;
+  auto patch = checkRoundTrip(old_value, changed);
+  ASSERT_EQ(patch, (Patch{Splice{2 + 500 * 4, 4, {7, 0, 0, 0}}}));
+
+  auto inserted = old_value;
+  inserted.insert(inserted.begin() + 10, 0xffffffff);
+  patch = checkRoundTrip(old_value, inserted);
+  // length prefix and the new element
+  ASSERT_EQ(patch.size(), 2);
+  ASSERT_EQ(patch[1].removed, 0);
+  ASSERT_EQ(patch[1].inserted, ByteArray(4, 0xff));
+
+  auto removed = old_value;
+  removed.pop_back();
+  checkRoundTrip(old_value, removed);
+  checkRoundTrip(old_value, std::vector<uint32_t>{});
+  checkRoundTrip(std::vector<uint32_t>{}, old_value);
+}
+
+/**
+ * @given vectors of zero-size elements, one of them with a huge count
+ * @when they are compared
+ * @then patch replaces only the length without counting on the elements
+ */
+TEST(Diff, ZeroSizeElements) {
+  using Empties = std::vector<std::tuple<>>;
+  auto old_encoded = scale::encode(Empties(3)).value();
+  // length of 2^30 - 1 elements
+  ByteArray new_encoded{0xfe, 0xff, 0xff, 0xff};
+  EXPECT_OUTCOME_TRUE(patch, scale::diff<Empties>(old_encoded, new_encoded));
+  ASSERT_EQ(patch, (Patch{Splice{0, 1, new_encoded}}));
+  EXPECT_OUTCOME_TRUE(patched, scale::patch(old_encoded, patch));
+  ASSERT_EQ(patched, new_encoded);
+}
+
+/**
+ * @given struct with collections and a map of variable-size values
+ * @when some of its parts change
+ * @then patch touches only changed fields and elements
+ */
+TEST(Diff, Struct) {
+  State old_state{1, {1, 2, 3}, {{1, "alice"}, {2, "bob"}, {3, "carol"}}};
+  auto new_state = old_state;
+  new_state.version = 2;
+  new_state.names[2] = "robert";
+  new_state.names[4] = "dave";
+  auto patch = checkRoundTrip(old_state, new_state);
+  // version, names length and the names after the common prefix
+  ASSERT_EQ(patch.size(), 3);
+  ASSERT_EQ(patch[0], (Splice{0, 8, {2, 0, 0, 0, 0, 0, 0, 0}}));
+
+  auto patch_encoded = scale::encode(patch).value();
+  ASSERT_EQ(scale::decode<Patch>(patch_encoded).value(), patch);
+
+  ASSERT_TRUE(checkRoundTrip(old_state, old_state).empty());
+}
+
+/**
+ * @given patches with splices out of order or beyond the value
+ * @when they are applied
+ * @then error is returned
+ */
+TEST(Diff, InvalidPatch) {
+  ByteArray value{1, 2, 3};
+  EXPECT_OUTCOME_FALSE(e1, scale::patch(value, Patch{{2, 2, {}}}));
+  ASSERT_EQ(e1, DiffError::INVALID_PATCH);
+  EXPECT_OUTCOME_FALSE(e2, scale::patch(value, Patch{{2, 0, {}}, {1, 0, {}}}));
+  ASSERT_EQ(e2, DiffError::INVALID_PATCH);
+  EXPECT_OUTCOME_TRUE(res, scale::patch(value, Patch{{3, 0, {4}}}));
+  ASSERT_EQ(res, (ByteArray{1, 2, 3, 4}));
+}
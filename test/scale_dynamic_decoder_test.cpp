@@ -0,0 +1,217 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/dynamic_decoder.hpp"
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::CompactInteger;
+using scale::DecodeError;
+using scale::ScaleDecoderStream;
+using namespace scale::dynamic;  // NOLINT
+
+namespace {
+  Value val(Value::Data data) {
+    return Value{std::move(data)};
+  }
+
+  Value list(std::vector<Value> values) {
+    return Value{std::move(values)};
+  }
+}  // namespace
+
+/**
+ * @given registry describing struct {u32, Vec<u8>, Vec<(u16, String)>,
+ * Compact<u128>, i8, Option<u32>}
+ * @when value of corresponding static type is decoded with the compiled plan
+ * @then generic value matches the original one
+ */
+TEST(DynamicDecoder, Composite) {
+  TypeRegistry registry;
+  auto u8 = registry.add(Primitive::U8);
+  auto u16 = registry.add(Primitive::U16);
+  auto u32 = registry.add(Primitive::U32);
+  auto u128 = registry.add(Primitive::U128);
+  auto i8 = registry.add(Primitive::I8);
+  auto str = registry.add(Primitive::STR);
+  auto bytes = registry.add(SequenceType{u8});
+  auto pair = registry.add(TupleType{{u16, str}});
+  auto pairs = registry.add(SequenceType{pair});
+  auto compact = registry.add(CompactType{u128});
+  auto option =
+      registry.add(VariantType{{{0, "None", {}}, {1, "Some", {u32}}}});
+  auto root = registry.add(CompositeType{{{"a", u32},
+                                          {"b", bytes},
+                                          {"c", pairs},
+                                          {"d", compact},
+                                          {"e", i8},
+                                          {"f", option}}});
+  EXPECT_OUTCOME_TRUE(plan, DecodePlan::compile(registry, root));
+
+  std::vector<std::pair<uint16_t, std::string>> c{{1, "x"}, {2, "yz"}};
+  CompactInteger d = CompactInteger{1} << 100;
+  EXPECT_OUTCOME_TRUE(
+      encoded,
+      scale::encode(uint32_t{7}, ByteArray{1, 2}, c, d, int8_t{-3},
+                    std::optional<uint32_t>{9}));
+  EXPECT_OUTCOME_TRUE(value, plan.decode(encoded));
+
+  auto c_value = list({list({val(uint64_t{1}), val(std::string{"x"})}),
+                       list({val(uint64_t{2}), val(std::string{"yz"})})});
+  auto expected = list({val(uint64_t{7}),
+                        val(ByteArray{1, 2}),
+                        c_value,
+                        val(d),
+                        val(int64_t{-3}),
+                        val(VariantValue{1, {val(uint64_t{9})}})});
+  ASSERT_EQ(value, expected);
+}
+
+/**
+ * @given recursive variant type List = Nil | Cons(u64, List)
+ * @when encoded list is decoded
+ * @then nested variant values are produced
+ */
+TEST(DynamicDecoder, RecursiveVariant) {
+  TypeRegistry registry;
+  auto u64 = registry.add(Primitive::U64);
+  auto list_type = registry.reserve();
+  registry.define(list_type,
+                  VariantType{{{0, "Nil", {}}, {1, "Cons", {u64, list_type}}}});
+  EXPECT_OUTCOME_TRUE(plan, DecodePlan::compile(registry, list_type));
+
+  ByteArray encoded{1, 5, 0, 0, 0, 0, 0, 0, 0, 0};
+  EXPECT_OUTCOME_TRUE(value, plan.decode(encoded));
+  ASSERT_EQ(value,
+            val(VariantValue{1,
+                             {val(uint64_t{5}), val(VariantValue{0, {}})}}));
+
+  ByteArray wrong_index{2};
+  EXPECT_OUTCOME_FALSE(err, plan.decode(wrong_index));
+  ASSERT_EQ(err, DecodeError::WRONG_TYPE_INDEX);
+}
+
+/**
+ * @given recursive struct Node {v: u32, child: Option<Node>, children:
+ * Vec<Node>}
+ * @when plans are compiled for it and for (Node,)
+ * @then both decode nested nodes
+ */
+TEST(DynamicDecoder, RecursiveComposite) {
+  TypeRegistry registry;
+  auto u32 = registry.add(Primitive::U32);
+  auto node = registry.reserve();
+  auto option =
+      registry.add(VariantType{{{0, "None", {}}, {1, "Some", {node}}}});
+  auto nodes = registry.add(SequenceType{node});
+  registry.define(
+      node,
+      CompositeType{{{"v", u32}, {"child", option}, {"children", nodes}}});
+  auto tuple = registry.add(TupleType{{node}});
+
+  // Node {1, Some(Node {2, None, []}), [Node {3, None, []}]}
+  ByteArray encoded{1, 0, 0, 0, 1, 2, 0, 0, 0, 0, 0, 4, 3, 0, 0, 0, 0, 0};
+  auto leaf = [](uint64_t v) {
+    return list({val(v), val(VariantValue{0, {}}), list({})});
+  };
+  auto expected = list({val(uint64_t{1}),
+                        val(VariantValue{1, {leaf(2)}}),
+                        list({leaf(3)})});
+
+  EXPECT_OUTCOME_TRUE(node_plan, DecodePlan::compile(registry, node));
+  EXPECT_OUTCOME_TRUE(node_value, node_plan.decode(encoded));
+  ASSERT_EQ(node_value, expected);
+
+  EXPECT_OUTCOME_TRUE(tuple_plan, DecodePlan::compile(registry, tuple));
+  EXPECT_OUTCOME_TRUE(tuple_value, tuple_plan.decode(encoded));
+  ASSERT_EQ(tuple_value, list({expected}));
+}
+
+/**
+ * @given recursive variant type List = Nil | Cons(u8, List)
+ * @when a list nested deeper than the limit is decoded
+ * @then decoding fails instead of exhausting the stack
+ */
+TEST(DynamicDecoder, NestingDepthLimit) {
+  TypeRegistry registry;
+  auto u8 = registry.add(Primitive::U8);
+  auto list_type = registry.reserve();
+  registry.define(list_type,
+                  VariantType{{{0, "Nil", {}}, {1, "Cons", {u8, list_type}}}});
+  EXPECT_OUTCOME_TRUE(plan, DecodePlan::compile(registry, list_type));
+
+  auto nested = [](size_t depth) {
+    ByteArray encoded;
+    for (size_t i = 0; i < depth; ++i) {
+      encoded.insert(encoded.end(), {1, 7});
+    }
+    encoded.push_back(0);
+    return encoded;
+  };
+  // a list of n items is made of n + 1 nested variants
+  EXPECT_OUTCOME_TRUE_1(plan.decode(nested(DecodePlan::kMaxNestingDepth - 1)));
+  EXPECT_OUTCOME_FALSE(err, plan.decode(nested(DecodePlan::kMaxNestingDepth)));
+  ASSERT_EQ(err, DecodeError::TOO_DEEP_NESTING);
+}
+
+/**
+ * @given malformed type descriptions
+ * @when plans are compiled for them
+ * @then corresponding errors are returned
+ */
+TEST(DynamicDecoder, CompileErrors) {
+  TypeRegistry registry;
+  auto str = registry.add(Primitive::STR);
+  auto unknown = registry.reserve();
+  auto self = registry.reserve();
+  registry.define(self, CompositeType{{{"self", self}}});
+
+  EXPECT_OUTCOME_FALSE(e1, DecodePlan::compile(registry, unknown));
+  ASSERT_EQ(e1, DynamicTypeError::UNKNOWN_TYPE);
+  EXPECT_OUTCOME_FALSE(
+      e2, DecodePlan::compile(registry, registry.add(CompactType{str})));
+  ASSERT_EQ(e2, DynamicTypeError::NOT_AN_INTEGER);
+  EXPECT_OUTCOME_FALSE(e3, DecodePlan::compile(registry, self));
+  ASSERT_EQ(e3, DynamicTypeError::INFINITE_TYPE);
+  auto duplicate = registry.add(VariantType{{{3, "A", {}}, {3, "B", {}}}});
+  EXPECT_OUTCOME_FALSE(e4, DecodePlan::compile(registry, duplicate));
+  ASSERT_EQ(e4, DynamicTypeError::DUPLICATE_VARIANT);
+}
+
+/**
+ * @given plan for fixed array of u8 and i128
+ * @when it is run with a custom visitor over a stream
+ * @then bytes are reported as a span into the data and the stream is consumed
+ */
+TEST(DynamicDecoder, Visitor) {
+  TypeRegistry registry;
+  auto u8 = registry.add(Primitive::U8);
+  auto i128 = registry.add(Primitive::I128);
+  auto root = registry.add(TupleType{{registry.add(ArrayType{u8, 3}), i128}});
+  EXPECT_OUTCOME_TRUE(plan, DecodePlan::compile(registry, root));
+
+  struct Collector : Visitor {
+    void onBytes(gsl::span<const uint8_t> v) override {
+      bytes = v;
+    }
+    void onBigInteger(const CompactInteger &v) override {
+      big = v;
+    }
+    gsl::span<const uint8_t> bytes;
+    CompactInteger big;
+  } collector;
+
+  ByteArray encoded{7, 8, 9};
+  encoded.resize(3 + 16, 0xff);
+  ScaleDecoderStream s{encoded};
+  plan.run(s, collector);
+  ASSERT_FALSE(s.hasMore(1));
+  ASSERT_EQ(collector.bytes.data(), encoded.data());
+  ASSERT_EQ(collector.bytes.size(), 3);
+  ASSERT_EQ(collector.big, -1);
+}
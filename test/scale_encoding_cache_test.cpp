@@ -0,0 +1,163 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "scale/encoding_cache.hpp"
+#include "scale/scatter_gather_sink.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::CachedEncoding;
+using scale::EncodingCache;
+using scale::ScaleEncoderStream;
+using scale::ScatterGatherSink;
+
+using Header = std::tuple<ByteArray, uint32_t, std::vector<std::string>>;
+
+namespace {
+  Header makeHeader(uint32_t number) {
+    return Header{ByteArray(32, number), number, {"digest", "seal"}};
+  }
+}  // namespace
+
+/**
+ * @given value wrapped into CachedEncoding
+ * @when it is encoded several times
+ * @then it is encoded as the value itself @and large encodings are passed to
+ * the sink by reference to the cached bytes
+ */
+TEST(CachedEncoding, Encode) {
+  CachedEncoding<Header> cached{makeHeader(1)};
+  auto expected = scale::encode(makeHeader(1)).value();
+  ASSERT_EQ(scale::encode(cached).value(), expected);
+  ASSERT_EQ(scale::encode(cached, cached).value().size(),
+            expected.size() * 2);
+
+  ScatterGatherSink sink;
+  ScaleEncoderStream s{sink, 16};
+  s << cached;
+  s.flush();
+  auto iov = sink.iovecs();
+  ASSERT_EQ(iov.size(), 1);
+  ASSERT_EQ(iov[0].iov_base, cached.encoded().data());
+}
+
+/**
+ * @given encoded value
+ * @when it is decoded as CachedEncoding
+ * @then the value is decoded @and its encoding is kept
+ */
+TEST(CachedEncoding, Decode) {
+  auto encoded = scale::encode(makeHeader(2), uint8_t{7}).value();
+  scale::ScaleDecoderStream s{encoded};
+  CachedEncoding<Header> cached;
+  uint8_t tail = 0;
+  s >> cached >> tail;
+  ASSERT_EQ(cached.get(), makeHeader(2));
+  ASSERT_EQ(tail, 7);
+  ASSERT_EQ(ByteArray(cached.encoded().begin(), cached.encoded().end()),
+            ByteArray(encoded.begin(), encoded.end() - 1));
+}
+
+/**
+ * @given cache with a byte budget
+ * @when objects are encoded through it
+ * @then repeated requests return the cached bytes until the object version
+ * changes @and newer versions replace older ones @and least recently used
+ * entries are evicted over the budget
+ */
+TEST(EncodingCache, HitsAndEviction) {
+  std::vector<Header> headers;
+  for (uint32_t i = 0; i < 4; ++i) {
+    headers.push_back(makeHeader(i));
+  }
+  auto size = scale::encode(headers[0]).value().size();
+  // room for two entries in a single shard
+  EncodingCache cache{size * 2, 1};
+
+  EXPECT_OUTCOME_TRUE(first, cache.encode(headers[0], 0));
+  ASSERT_EQ(*first, scale::encode(headers[0]).value());
+  EXPECT_OUTCOME_TRUE(hit, cache.encode(headers[0], 0));
+  ASSERT_EQ(hit, first);
+  EXPECT_OUTCOME_TRUE(next_version, cache.encode(headers[0], 1));
+  ASSERT_NE(next_version, first);
+  ASSERT_EQ(cache.size(), size);
+
+  // older version is encoded again and not cached
+  EXPECT_OUTCOME_TRUE(outdated, cache.encode(headers[0], 0));
+  ASSERT_NE(outdated, first);
+  ASSERT_EQ(*outdated, *first);
+  EXPECT_OUTCOME_TRUE(latest, cache.encode(headers[0], 1));
+  ASSERT_EQ(latest, next_version);
+
+  // evicts the first header, which is the least recently used
+  EXPECT_OUTCOME_TRUE(second, cache.encode(headers[1], 0));
+  EXPECT_OUTCOME_TRUE_1(cache.encode(headers[2], 0));
+  ASSERT_EQ(cache.size(), size * 2);
+  EXPECT_OUTCOME_TRUE(still_cached, cache.encode(headers[1], 0));
+  ASSERT_EQ(still_cached, second);
+  EXPECT_OUTCOME_TRUE(evicted, cache.encode(headers[0], 1));
+  ASSERT_NE(evicted, next_version);
+  // evicted encoding stays valid for its holders
+  ASSERT_EQ(*next_version, *evicted);
+
+  cache.erase(&headers[0]);
+  ASSERT_EQ(cache.size(), size);
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+}
+
+/**
+ * @given struct and its first field, which share the address
+ * @when both are encoded through the cache
+ * @then each of them gets its own encoding
+ */
+TEST(EncodingCache, ObjectsAtTheSameAddress) {
+  std::pair<Header, uint8_t> pair{makeHeader(5), 9};
+  EncodingCache cache{1u << 12u};
+  EXPECT_OUTCOME_TRUE(header, cache.encode(pair.first, 0));
+  EXPECT_OUTCOME_TRUE(whole, cache.encode(pair, 0));
+  ASSERT_EQ(*header, scale::encode(pair.first).value());
+  ASSERT_EQ(*whole, scale::encode(pair).value());
+
+  cache.erase(&pair);
+  ASSERT_EQ(cache.size(), 0);
+}
+
+/**
+ * @given sharded cache
+ * @when objects are encoded through it from several threads
+ * @then all the threads get correct encodings
+ */
+TEST(EncodingCache, Concurrent) {
+  std::vector<Header> headers;
+  for (uint32_t i = 0; i < 64; ++i) {
+    headers.push_back(makeHeader(i));
+  }
+  EncodingCache cache{1u << 12u};
+  std::vector<std::thread> threads;
+  std::atomic<size_t> mismatches = 0;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (size_t round = 0; round < 100; ++round) {
+        for (const auto &header : headers) {
+          if (*cache.encode(header, round % 3).value()
+              != scale::encode(header).value()) {
+            ++mismatches;
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(mismatches, 0);
+  ASSERT_LE(cache.size(), 1u << 12u);
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/extract.hpp"
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::CompactInteger;
+using scale::ExtractError;
+using scale::kStaticSize;
+using scale::ScaleDecoderStream;
+namespace path = scale::path;
+
+struct Transfer {
+  SCALE_TIE(3);
+  std::array<uint8_t, 32> from;
+  std::array<uint8_t, 32> to;
+  CompactInteger amount;
+
+  bool operator==(const Transfer &other) const {
+    return as_tie() == other.as_tie();
+  }
+};
+
+struct Remark {
+  SCALE_TIE(1);
+  std::string text;
+
+  bool operator==(const Remark &other) const {
+    return text == other.text;
+  }
+};
+
+using Event = boost::variant<Remark, std::pair<uint32_t, uint64_t>, Transfer>;
+
+struct Block {
+  SCALE_TIE(4);
+  uint32_t number;
+  std::optional<ByteArray> justification;
+  std::map<uint32_t, std::string> digest;
+  std::vector<Event> events;
+};
+
+namespace {
+  Block makeBlock() {
+    Transfer transfer{};
+    transfer.from.fill(1);
+    transfer.to.fill(2);
+    transfer.amount = CompactInteger{1} << 70;
+    return Block{7,
+                 ByteArray{1, 2, 3},
+                 {{1, "a"}, {2, "bc"}},
+                 {Remark{"hello"},
+                  std::make_pair(5u, uint64_t{6}),
+                  transfer,
+                  Remark{std::string(100, 'x')}}};
+  }
+}  // namespace
+
+/**
+ * @given types of static and dynamic encoded size
+ * @then static size is known only for the former
+ */
+TEST(Extract, StaticSize) {
+  static_assert(*kStaticSize<uint64_t> == 8);
+  static_assert(*kStaticSize<std::pair<uint8_t, std::array<uint16_t, 3>>>
+                == 7);
+  static_assert(not kStaticSize<Transfer>);
+  static_assert(not kStaticSize<std::vector<uint8_t>>);
+  static_assert(not kStaticSize<std::optional<uint8_t>>);
+}
+
+/**
+ * @given encoded struct described with SCALE_TIE
+ * @when it is decoded or skipped
+ * @then decoded value equals the original and skip reaches the end
+ */
+TEST(Extract, TieAndSkip) {
+  auto block = makeBlock();
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(block));
+  EXPECT_OUTCOME_TRUE(decoded, scale::decode<Block>(encoded));
+  ASSERT_TRUE(decoded.as_tie() == block.as_tie());
+
+  ScaleDecoderStream s{encoded};
+  scale::skip<Block>(s);
+  ASSERT_FALSE(s.hasMore(1));
+}
+
+/**
+ * @given encoded block
+ * @when fields are extracted by paths
+ * @then they equal fields of the original block, wrong paths give errors
+ */
+TEST(Extract, Paths) {
+  auto block = makeBlock();
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(block));
+
+  EXPECT_OUTCOME_TRUE(amount,
+                      scale::extract<Block>(encoded,
+                                            path::field<3>,
+                                            path::element(2),
+                                            path::arm<2>,
+                                            path::field<2>));
+  ASSERT_EQ(amount, CompactInteger{1} << 70);
+
+  EXPECT_OUTCOME_TRUE(
+      text,
+      scale::extract<Block>(
+          encoded, path::field<3>, path::element(0), path::arm<0>));
+  ASSERT_EQ(text.text, "hello");
+
+  EXPECT_OUTCOME_TRUE(digest_item,
+                      scale::extract<Block>(
+                          encoded, path::field<2>, path::element(1)));
+  ASSERT_EQ(digest_item, (std::pair<uint32_t, std::string>{2, "bc"}));
+
+  EXPECT_OUTCOME_TRUE(
+      justification,
+      scale::extractBytes<Block>(encoded, path::field<1>, path::arm<1>));
+  ASSERT_EQ(ByteArray(justification.begin(), justification.end()),
+            (ByteArray{3 << 2, 1, 2, 3}));
+
+  EXPECT_OUTCOME_TRUE(to_bytes,
+                      scale::extractBytes<Block>(encoded,
+                                                 path::field<3>,
+                                                 path::element(2),
+                                                 path::arm<2>,
+                                                 path::field<1>));
+  ASSERT_EQ(ByteArray(to_bytes.begin(), to_bytes.end()), ByteArray(32, 2));
+
+  EXPECT_OUTCOME_FALSE(
+      e1,
+      scale::extract<Block>(
+          encoded, path::field<3>, path::element(1), path::arm<0>));
+  ASSERT_EQ(e1, ExtractError::ARM_MISMATCH);
+  EXPECT_OUTCOME_FALSE(
+      e2, scale::extract<Block>(encoded, path::field<3>, path::element(4)));
+  ASSERT_EQ(e2, ExtractError::INDEX_OUT_OF_RANGE);
+}
@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/hashing_sinks.hpp"
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::Blake2b256Sink;
+using scale::ByteArray;
+using scale::hashEncoded;
+using scale::Twox128Sink;
+using scale::XxHash64Sink;
+
+namespace {
+  gsl::span<const uint8_t> bytes(std::string_view s) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return {reinterpret_cast<const uint8_t *>(s.data()),
+            static_cast<gsl::span<const uint8_t>::index_type>(s.size())};
+  }
+
+  std::string hex(gsl::span<const uint8_t> data) {
+    static constexpr char kDigits[] = "0123456789abcdef";
+    std::string res;
+    for (auto b : data) {
+      res += kDigits[b >> 4u];
+      res += kDigits[b & 0xfu];
+    }
+    return res;
+  }
+
+  template <class Sink>
+  auto hashOf(std::string_view s) {
+    Sink sink;
+    sink.write(bytes(s));
+    return sink.finish();
+  }
+}  // namespace
+
+/**
+ * @given known test vectors
+ * @when they are hashed by the sinks
+ * @then reference hashes are produced
+ */
+TEST(HashingSinks, KnownVectors) {
+  ASSERT_EQ(
+      hex(hashOf<Blake2b256Sink>("")),
+      "0e5751c026e543b2e8ab2eb06099daa1d1e5df47778f7787faab45cdf12fe3a8");
+  ASSERT_EQ(
+      hex(hashOf<Blake2b256Sink>("abc")),
+      "bddd813c634239723171ef3fee98579b94964e3bb1cb3e427262c8c068d52319");
+  ASSERT_EQ(hashOf<XxHash64Sink>(""), 0xef46db3751d8e999ull);
+  ASSERT_EQ(hashOf<XxHash64Sink>("abc"), 0x44bc2cf5ad770999ull);
+  ASSERT_EQ(hex(hashOf<Twox128Sink>("System")),
+            "26aa394eea5630e07c48ae0c9558cef7");
+}
+
+/**
+ * @given data of various sizes around block boundaries
+ * @when it is written to the sinks at once and in small chunks
+ * @then hashes are the same
+ */
+TEST(HashingSinks, ChunkedWrites) {
+  for (size_t size : {0, 1, 31, 32, 33, 127, 128, 129, 256, 1000}) {
+    ByteArray data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = static_cast<uint8_t>(i * 7);
+    }
+    Blake2b256Sink blake_whole;
+    Blake2b256Sink blake_chunked;
+    Twox128Sink twox_whole;
+    Twox128Sink twox_chunked;
+    blake_whole.write(data);
+    twox_whole.write(data);
+    for (size_t i = 0; i < size; i += 5) {
+      auto chunk =
+          gsl::make_span(data).subspan(i, std::min<size_t>(5, size - i));
+      blake_chunked.write(chunk);
+      twox_chunked.write(chunk);
+    }
+    ASSERT_EQ(blake_whole.finish(), blake_chunked.finish()) << size;
+    ASSERT_EQ(twox_whole.finish(), twox_chunked.finish()) << size;
+  }
+}
+
+/**
+ * @given values with large and small fields
+ * @when they are hashed with hashEncoded
+ * @then result matches hash of the encoded data
+ */
+TEST(HashingSinks, HashEncoded) {
+  ByteArray payload(10000, 0xab);
+  std::vector<uint32_t> numbers{1, 2, 3};
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(payload, numbers, uint8_t{7}));
+
+  EXPECT_OUTCOME_TRUE(
+      blake, hashEncoded<Blake2b256Sink>(payload, numbers, uint8_t{7}));
+  Blake2b256Sink blake_sink;
+  blake_sink.write(encoded);
+  ASSERT_EQ(blake, blake_sink.finish());
+
+  EXPECT_OUTCOME_TRUE(
+      xx, hashEncoded<XxHash64Sink>(payload, numbers, uint8_t{7}));
+  XxHash64Sink xx_sink;
+  xx_sink.write(encoded);
+  ASSERT_EQ(xx, xx_sink.finish());
+}
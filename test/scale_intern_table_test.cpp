@@ -0,0 +1,92 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/buffer/buffer.hpp"
+#include "scale/intern_table.hpp"
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::Buffer;
+using scale::ByteArray;
+using scale::InternTable;
+using scale::Interned;
+using scale::ScaleDecoderStream;
+
+using AccountId = std::array<uint8_t, 32>;
+
+struct Event {
+  Interned<AccountId> account;
+  Interned<std::string> name;
+  Interned<Buffer> data;
+};
+
+template <class Stream, typename = std::enable_if_t<Stream::is_decoder_stream>>
+Stream &operator>>(Stream &s, Event &v) {
+  return s >> v.account >> v.name >> v.data;
+}
+
+/**
+ * @given encoded events repeating the same accounts, names and data
+ * @when they are decoded with an intern table
+ * @then equal values share the same copy and large ones are not interned
+ */
+TEST(InternTable, SharesRepeatedValues) {
+  AccountId alice{};
+  alice.fill(1);
+  AccountId bob{};
+  bob.fill(2);
+  std::vector<std::tuple<AccountId, std::string, Buffer>> events{
+      {alice, "Transfer", Buffer{1, 2}},
+      {bob, "Transfer", Buffer(100, 3)},
+      {alice, "Deposit", Buffer(100, 3)},
+  };
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(events));
+
+  InternTable table;
+  ScaleDecoderStream s{encoded};
+  s.setInternTable(&table);
+  std::vector<Event> decoded;
+  s >> decoded;
+
+  ASSERT_EQ(decoded.size(), 3);
+  ASSERT_EQ(*decoded[1].account, bob);
+  ASSERT_EQ(*decoded[2].name, "Deposit");
+  ASSERT_EQ(&*decoded[0].account, &*decoded[2].account);
+  ASSERT_EQ(&*decoded[0].name, &*decoded[1].name);
+  ASSERT_EQ(decoded[1].data, decoded[2].data);
+  ASSERT_NE(&*decoded[1].data, &*decoded[2].data);
+  // alice, bob, 2 names, small data
+  ASSERT_EQ(table.size(), 5);
+
+  EXPECT_OUTCOME_TRUE(reencoded, scale::encode(decoded[0].account));
+  ASSERT_EQ(reencoded, ByteArray(alice.begin(), alice.end()));
+}
+
+/**
+ * @given encoded byte strings
+ * @when they are decoded without an intern table
+ * @then each value has its own copy
+ */
+TEST(InternTable, NoTable) {
+  EXPECT_OUTCOME_TRUE(
+      encoded, scale::encode(std::vector<ByteArray>{{1, 2, 3}, {1, 2, 3}}));
+  EXPECT_OUTCOME_TRUE(decoded,
+                      scale::decode<std::vector<Interned<ByteArray>>>(encoded));
+  ASSERT_EQ(decoded[0], decoded[1]);
+  ASSERT_NE(&*decoded[0], &*decoded[1]);
+}
+
+/**
+ * @given default-constructed handles
+ * @when they are compared
+ * @then they share one empty value
+ */
+TEST(InternTable, DefaultHandlesShareEmptyValue) {
+  std::vector<Interned<ByteArray>> handles(3);
+  ASSERT_TRUE(handles[0]->empty());
+  ASSERT_EQ(&*handles[0], &*handles[2]);
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/jagged_bytes.hpp"
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::DecodeError;
+using scale::JaggedBytes;
+
+namespace {
+  std::vector<ByteArray> makeArrays() {
+    std::vector<ByteArray> arrays;
+    for (size_t i = 0; i < 300; ++i) {
+      // lengths take one, two and four bytes
+      auto length = i % 3 == 0 ? i : i * 100;
+      arrays.emplace_back(length, static_cast<uint8_t>(i));
+    }
+    arrays.emplace_back();
+    return arrays;
+  }
+}  // namespace
+
+/**
+ * @given encoded vector of byte vectors
+ * @when it is decoded as JaggedBytes
+ * @then arrays are equal to the encoded ones @and encoding them gives the
+ * same bytes
+ */
+TEST(JaggedBytes, RoundTrip) {
+  auto arrays = makeArrays();
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(arrays));
+  EXPECT_OUTCOME_TRUE(jagged, scale::decode<JaggedBytes>(encoded));
+
+  ASSERT_EQ(jagged.size(), arrays.size());
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    auto array = jagged[i];
+    ASSERT_EQ(ByteArray(array.begin(), array.end()), arrays[i]);
+  }
+  ASSERT_EQ(jagged.toVectors(), arrays);
+  ASSERT_EQ(jagged, JaggedBytes{arrays});
+
+  EXPECT_OUTCOME_TRUE(reencoded, scale::encode(jagged));
+  ASSERT_EQ(reencoded, encoded);
+}
+
+/**
+ * @given encoded vector of byte vectors, truncated or with a huge count
+ * @when it is decoded as JaggedBytes
+ * @then NOT_ENOUGH_DATA error is returned
+ */
+TEST(JaggedBytes, Truncated) {
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(makeArrays()));
+  encoded.resize(encoded.size() - 2);
+  EXPECT_OUTCOME_FALSE(e, scale::decode<JaggedBytes>(encoded));
+  ASSERT_EQ(e, DecodeError::NOT_ENOUGH_DATA);
+
+  // count of 2^30 arrays followed by a single byte
+  ByteArray huge{0x03, 0x00, 0x00, 0x00, 0x40, 0x00};
+  EXPECT_OUTCOME_FALSE(huge_error, scale::decode<JaggedBytes>(huge));
+  ASSERT_EQ(huge_error, DecodeError::NOT_ENOUGH_DATA);
+}
@@ -0,0 +1,152 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/lazy_vec.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::LazyVec;
+
+struct Event {
+  SCALE_TIE(3);
+  uint32_t index;
+  std::string name;
+  std::vector<uint64_t> topics;
+
+  bool operator==(const Event &other) const {
+    return as_tie() == other.as_tie();
+  }
+};
+
+struct Block {
+  SCALE_TIE(3);
+  uint64_t number;
+  LazyVec<Event> events;
+  uint32_t tail;
+};
+
+namespace {
+  std::vector<Event> makeEvents() {
+    std::vector<Event> events;
+    for (uint32_t i = 0; i < 50; ++i) {
+      events.push_back(Event{
+          i, "event" + std::to_string(i), std::vector<uint64_t>(i % 4, i)});
+    }
+    return events;
+  }
+}  // namespace
+
+/**
+ * @given struct with a vector of variable-size elements decoded as LazyVec
+ * @when elements are accessed
+ * @then they are decoded from kept bytes @and the struct is encoded back
+ * unchanged
+ */
+TEST(LazyVec, VariableSizeElements) {
+  auto events = makeEvents();
+  EXPECT_OUTCOME_TRUE(
+      encoded, scale::encode(uint64_t{7}, events, uint32_t{0xdeadbeef}));
+
+  EXPECT_OUTCOME_TRUE(block, scale::decode<Block>(encoded));
+  ASSERT_EQ(block.number, 7);
+  ASSERT_EQ(block.tail, 0xdeadbeef);
+  ASSERT_EQ(block.events.size(), events.size());
+
+  EXPECT_OUTCOME_TRUE(event, block.events.get(17));
+  ASSERT_EQ(event, events[17]);
+  EXPECT_OUTCOME_TRUE(last, block.events.get(49));
+  ASSERT_EQ(last, events[49]);
+
+  EXPECT_OUTCOME_TRUE(cached, block.events.getCached(3));
+  EXPECT_OUTCOME_TRUE(cached_again, block.events.getCached(3));
+  ASSERT_EQ(cached, cached_again);
+  ASSERT_EQ(*cached, events[3]);
+
+  EXPECT_OUTCOME_TRUE(all, block.events.decodeAll());
+  ASSERT_EQ(all, events);
+
+  EXPECT_OUTCOME_TRUE(reencoded, scale::encode(block));
+  ASSERT_EQ(reencoded, encoded);
+
+  ASSERT_EQ(LazyVec<Event>{events}, block.events);
+}
+
+/**
+ * @given vector of static-size elements
+ * @when it is decoded as LazyVec
+ * @then elements are located without offsets
+ */
+TEST(LazyVec, StaticSizeElements) {
+  using Pair = std::pair<uint32_t, uint16_t>;
+  std::vector<Pair> pairs;
+  for (uint32_t i = 0; i < 10; ++i) {
+    pairs.emplace_back(i * 1000, i);
+  }
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(pairs));
+  EXPECT_OUTCOME_TRUE(lazy, scale::decode<LazyVec<Pair>>(encoded));
+  ASSERT_EQ(lazy.encodedElements().size(), 60);
+  EXPECT_OUTCOME_TRUE(pair, lazy.get(9));
+  ASSERT_EQ(pair, pairs[9]);
+  EXPECT_OUTCOME_TRUE(reencoded, scale::encode(lazy));
+  ASSERT_EQ(reencoded, encoded);
+}
+
+/**
+ * @given truncated encoded vector
+ * @when it is decoded as LazyVec
+ * @then error is returned
+ */
+TEST(LazyVec, Truncated) {
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(makeEvents()));
+  encoded.pop_back();
+  EXPECT_OUTCOME_FALSE(e, scale::decode<LazyVec<Event>>(encoded));
+  ASSERT_EQ(e, scale::DecodeError::NOT_ENOUGH_DATA);
+}
+
+/**
+ * @given vector of elements with Compact fields
+ * @when it is decoded as LazyVec
+ * @then elements are decoded from kept bytes
+ */
+TEST(LazyVec, CompactElements) {
+  using Entry = std::pair<scale::Compact<uint32_t>, ByteArray>;
+  std::vector<Entry> entries{{{300}, {1, 2}}, {{70000}, {3}}, {{1}, {}}};
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(entries, uint8_t{9}));
+  EXPECT_OUTCOME_TRUE(decoded,
+                      (scale::decode<std::pair<LazyVec<Entry>, uint8_t>>(
+                          encoded)));
+  ASSERT_EQ(decoded.second, 9);
+  EXPECT_OUTCOME_TRUE(entry, decoded.first.get(1));
+  ASSERT_EQ(entry, entries[1]);
+  EXPECT_OUTCOME_TRUE(all, decoded.first.decodeAll());
+  ASSERT_EQ(all, entries);
+}
+
+/**
+ * @given vector of elements of zero size
+ * @when it is decoded as LazyVec
+ * @then its length is kept @and no bytes are consumed @and the cache does
+ * not grow with the length
+ */
+TEST(LazyVec, ZeroSizeElements) {
+  using Empty = std::tuple<>;
+  ByteArray encoded{0x0c, 0x07};
+  EXPECT_OUTCOME_TRUE(decoded,
+                      (scale::decode<std::pair<LazyVec<Empty>, uint8_t>>(
+                          encoded)));
+  ASSERT_EQ(decoded.first.size(), 3);
+  ASSERT_EQ(decoded.second, 7);
+
+  // length of 2^30 - 1 elements
+  EXPECT_OUTCOME_TRUE(huge,
+                      scale::decode<LazyVec<Empty>>(
+                          ByteArray{0xfe, 0xff, 0xff, 0xff}));
+  ASSERT_EQ(huge.size(), (1u << 30u) - 1);
+  EXPECT_OUTCOME_TRUE(first, huge.getCached(0));
+  EXPECT_OUTCOME_TRUE(last, huge.getCached(huge.size() - 1));
+  ASSERT_EQ(first, last);
+}
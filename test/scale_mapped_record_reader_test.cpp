@@ -0,0 +1,118 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "scale/mapped_record_reader.hpp"
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::DecodeError;
+using scale::MappedRecordReader;
+
+class MappedRecordReaderTest : public ::testing::Test {
+ public:
+  void TearDown() override {
+    std::remove(path_.c_str());
+  }
+
+ protected:
+  void writeFile(const ByteArray &content) {
+    std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(content.data()), content.size());
+  }
+
+  std::string path_ = ::testing::TempDir() + "scale_mapped_records.bin";
+};
+
+/**
+ * @given file of length prefixed records
+ * @when it is iterated with MappedRecordReader
+ * @then each record is obtained as a span @and decoded lazily
+ */
+TEST_F(MappedRecordReaderTest, LengthPrefixedRecords) {
+  std::vector<std::pair<uint32_t, std::string>> values{
+      {1, "first"}, {2, "second"}, {3, std::string(100, 'x')}};
+  ByteArray content;
+  for (const auto &value : values) {
+    auto record = scale::encode(scale::encode(value).value()).value();
+    content.insert(content.end(), record.begin(), record.end());
+  }
+  writeFile(content);
+
+  EXPECT_OUTCOME_TRUE(reader, MappedRecordReader::open(path_));
+  size_t i = 0;
+  for (auto record : reader) {
+    ASSERT_LT(i, values.size());
+    EXPECT_OUTCOME_TRUE(
+        decoded, (scale::decode<std::pair<uint32_t, std::string>>(record)));
+    ASSERT_EQ(decoded, values[i]);
+    ++i;
+  }
+  ASSERT_EQ(i, values.size());
+  ASSERT_TRUE(reader.atEnd());
+  ASSERT_EQ(reader.offset(), content.size());
+}
+
+/**
+ * @given file of self-delimiting records
+ * @when they are decoded one by one
+ * @then original values are obtained @and rewind restarts reading
+ */
+TEST_F(MappedRecordReaderTest, SelfDelimitingRecords) {
+  std::vector<std::string> values{"a", "bb", "ccc"};
+  ByteArray content;
+  for (const auto &value : values) {
+    auto record = scale::encode(value).value();
+    content.insert(content.end(), record.begin(), record.end());
+  }
+  writeFile(content);
+
+  EXPECT_OUTCOME_TRUE(reader, MappedRecordReader::open(path_, false));
+  for (const auto &value : values) {
+    EXPECT_OUTCOME_TRUE(decoded, reader.next<std::string>());
+    ASSERT_EQ(decoded, value);
+  }
+  EXPECT_OUTCOME_TRUE(last, reader.next<std::string>());
+  ASSERT_FALSE(last.has_value());
+
+  reader.rewind();
+  EXPECT_OUTCOME_TRUE(first, reader.next<std::string>());
+  ASSERT_EQ(first, values[0]);
+}
+
+/**
+ * @given file with a truncated record and an empty file
+ * @when they are read
+ * @then truncation is reported as NOT_ENOUGH_DATA @and empty file has no
+ * records
+ */
+TEST_F(MappedRecordReaderTest, TruncatedAndEmptyFiles) {
+  writeFile(ByteArray{12, 1, 2});
+  {
+    EXPECT_OUTCOME_TRUE(reader, MappedRecordReader::open(path_));
+    EXPECT_OUTCOME_FALSE(error, reader.nextRecord());
+    ASSERT_EQ(error, DecodeError::NOT_ENOUGH_DATA);
+  }
+
+  writeFile(ByteArray{});
+  EXPECT_OUTCOME_TRUE(reader, MappedRecordReader::open(path_));
+  ASSERT_TRUE(reader.atEnd());
+  ASSERT_TRUE(reader.begin() == reader.end());
+}
+
+/**
+ * @given path to a missing file
+ * @when it is opened
+ * @then system error is returned
+ */
+TEST_F(MappedRecordReaderTest, MissingFile) {
+  EXPECT_OUTCOME_FALSE(error, MappedRecordReader::open(path_ + ".missing"));
+  ASSERT_EQ(error, std::errc::no_such_file_or_directory);
+}
@@ -0,0 +1,147 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/resource.h>
+
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+
+#include "scale/record_log.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::RecordLogError;
+using scale::RecordLogReader;
+using scale::RecordLogWriter;
+
+using Record = std::pair<uint32_t, std::string>;
+
+class RecordLogTest : public ::testing::Test {
+ public:
+  void TearDown() override {
+    std::remove(path_.c_str());
+    std::remove((path_ + ".idx").c_str());
+  }
+
+ protected:
+  std::string path_ = ::testing::TempDir() + "scale_record_log.bin";
+};
+
+/**
+ * @given records of various sizes, including ones with multibyte length
+ * @when they are appended to the log in two writer sessions
+ * @then they are available both sequentially and by record number
+ */
+TEST_F(RecordLogTest, AppendAndRead) {
+  std::vector<Record> records{{1, "a"},
+                              {2, std::string(100, 'b')},
+                              {3, std::string(20000, 'c')},
+                              {4, ""}};
+  {
+    RecordLogWriter::Options options;
+    options.buffer_size = 64;
+    options.group_commit_records = 2;
+    EXPECT_OUTCOME_TRUE(writer, RecordLogWriter::open(path_, options));
+    for (size_t i = 0; i < 3; ++i) {
+      EXPECT_OUTCOME_TRUE(number, writer.append(records[i]));
+      ASSERT_EQ(number, i);
+    }
+  }
+  {
+    EXPECT_OUTCOME_TRUE(writer, RecordLogWriter::open(path_));
+    ASSERT_EQ(writer.size(), 3);
+    EXPECT_OUTCOME_TRUE(number, writer.append(records[3]));
+    ASSERT_EQ(number, 3);
+    EXPECT_OUTCOME_TRUE_1(writer.sync());
+  }
+
+  EXPECT_OUTCOME_TRUE(reader, RecordLogReader::open(path_));
+  ASSERT_EQ(reader.size(), records.size());
+  for (size_t i = records.size(); i-- > 0;) {
+    EXPECT_OUTCOME_TRUE(record, reader.get<Record>(i));
+    ASSERT_EQ(record, records[i]);
+  }
+  for (const auto &expected : records) {
+    EXPECT_OUTCOME_TRUE(bytes, reader.next());
+    ASSERT_TRUE(bytes.has_value());
+    EXPECT_OUTCOME_TRUE(record, scale::decode<Record>(*bytes));
+    ASSERT_EQ(record, expected);
+  }
+  EXPECT_OUTCOME_TRUE(end, reader.next());
+  ASSERT_FALSE(end.has_value());
+
+  EXPECT_OUTCOME_FALSE(error, reader.at(records.size()));
+  ASSERT_EQ(error, RecordLogError::INDEX_OUT_OF_RANGE);
+}
+
+/**
+ * @given log with a damaged record
+ * @when the record is read
+ * @then checksum mismatch is reported
+ */
+TEST_F(RecordLogTest, DetectsCorruption) {
+  {
+    EXPECT_OUTCOME_TRUE(writer, RecordLogWriter::open(path_));
+    EXPECT_OUTCOME_TRUE_1(writer.append(Record{1, "intact"}));
+    EXPECT_OUTCOME_TRUE_1(writer.append(Record{2, "damaged"}));
+  }
+  {
+    std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-6, std::ios::end);
+    file.put('X');
+  }
+
+  EXPECT_OUTCOME_TRUE(reader, RecordLogReader::open(path_));
+  EXPECT_OUTCOME_TRUE_1(reader.at(0));
+  EXPECT_OUTCOME_FALSE(error, reader.at(1));
+  ASSERT_EQ(error, RecordLogError::CHECKSUM_MISMATCH);
+}
+
+/**
+ * @given log files, which cannot grow enough to hold a record
+ * @when the record is appended @and written partially
+ * @then append fails without leaving the record in the log @and records
+ * appended later are read back intact
+ */
+TEST_F(RecordLogTest, FailedWriteLeavesNoRecord) {
+  RecordLogWriter::Options options;
+  options.buffer_size = 1;
+  EXPECT_OUTCOME_TRUE(writer, RecordLogWriter::open(path_, options));
+  EXPECT_OUTCOME_TRUE_1(writer.append(Record{1, "first"}));
+
+  // writes beyond the limit fail with EFBIG instead of raising SIGXFSZ
+  auto handler = std::signal(SIGXFSZ, SIG_IGN);
+  rlimit limit{};
+  ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &limit), 0);
+  auto restricted = limit;
+  restricted.rlim_cur = 64;
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &restricted), 0);
+  auto failed = writer.append(Record{2, std::string(100, 'x')});
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+  std::signal(SIGXFSZ, handler);
+  ASSERT_FALSE(failed);
+  ASSERT_EQ(writer.size(), 1);
+
+  EXPECT_OUTCOME_TRUE(number, writer.append(Record{3, "third"}));
+  ASSERT_EQ(number, 1);
+  EXPECT_OUTCOME_TRUE_1(writer.sync());
+
+  EXPECT_OUTCOME_TRUE(reader, RecordLogReader::open(path_));
+  ASSERT_EQ(reader.size(), 2);
+  EXPECT_OUTCOME_TRUE(second, reader.get<Record>(1));
+  ASSERT_EQ(second, (Record{3, "third"}));
+  size_t count = 0;
+  while (true) {
+    EXPECT_OUTCOME_TRUE(bytes, reader.next());
+    if (not bytes) {
+      break;
+    }
+    ++count;
+  }
+  ASSERT_EQ(count, 2);
+}
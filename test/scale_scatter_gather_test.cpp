@@ -0,0 +1,113 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/scale.hpp"
+#include "scale/scatter_gather_sink.hpp"
+
+using scale::ByteArray;
+using scale::ScaleEncoderStream;
+using scale::ScatterGatherSink;
+
+struct Extrinsic {
+  uint32_t nonce;
+  ByteArray payload;
+  std::string memo;
+};
+
+template <class Stream, typename = std::enable_if_t<Stream::is_encoder_stream>>
+Stream &operator<<(Stream &s, const Extrinsic &v) {
+  s << v.nonce << scale::CompactInteger{v.payload.size()};
+  s.putReferencedBytes(v.payload);
+  return s << v.memo;
+}
+
+// encodes bytes of a temporary, which is released before the sink is read
+struct Filler {
+  uint8_t value;
+};
+
+template <class Stream, typename = std::enable_if_t<Stream::is_encoder_stream>>
+Stream &operator<<(Stream &s, const Filler &v) {
+  ByteArray bytes(300, v.value);
+  return s << bytes;
+}
+
+ByteArray gather(const std::vector<iovec> &iov) {
+  ByteArray result;
+  for (const auto &v : iov) {
+    auto *base = static_cast<const uint8_t *>(v.iov_base);
+    result.insert(result.end(), base, base + v.iov_len);
+  }
+  return result;
+}
+
+/**
+ * @given extrinsics with payloads both smaller and larger than the threshold
+ * @when they are encoded to a scatter-gather sink
+ * @then large payloads are referenced in place @and gathered data equals
+ * regular encoding result
+ */
+TEST(ScatterGatherSinkTest, ReferencesLargePayloads) {
+  std::vector<Extrinsic> extrinsics{{1, ByteArray(1000, 0xAA), "first"},
+                                    {2, ByteArray(10, 0xBB), "second"},
+                                    {3, ByteArray(300, 0xCC), "third"}};
+
+  ScatterGatherSink sink;
+  ScaleEncoderStream s{sink, 256};
+  s << extrinsics;
+  s.flush();
+
+  auto iov = sink.iovecs();
+  ASSERT_EQ(iov.size(), 5);
+  ASSERT_EQ(iov[1].iov_base, extrinsics[0].payload.data());
+  ASSERT_EQ(iov[3].iov_base, extrinsics[2].payload.data());
+
+  auto expected = scale::encode(extrinsics).value();
+  ASSERT_EQ(sink.size(), expected.size());
+  ASSERT_EQ(s.size(), expected.size());
+  ASSERT_EQ(gather(iov), expected);
+}
+
+/**
+ * @given a value without large byte ranges
+ * @when it is encoded to a scatter-gather sink with small stream buffer
+ * @then all the data is kept in a single own segment
+ */
+TEST(ScatterGatherSinkTest, MergesBufferedWrites) {
+  ScatterGatherSink sink;
+  ScaleEncoderStream s{sink, 4};
+  s << uint64_t{42} << std::string("abc") << uint16_t{7};
+  s.flush();
+
+  auto iov = sink.iovecs();
+  ASSERT_EQ(iov.size(), 1);
+  ASSERT_EQ(gather(iov),
+            scale::encode(uint64_t{42}, std::string("abc"), uint16_t{7}).value());
+
+  sink.clear();
+  ASSERT_EQ(sink.size(), 0);
+  ASSERT_TRUE(sink.iovecs().empty());
+}
+
+/**
+ * @given values encoding byte ranges of temporaries larger than the threshold
+ * @when they are encoded to a scatter-gather sink
+ * @then the ranges are copied to the sink @and gathered data equals regular
+ * encoding result
+ */
+TEST(ScatterGatherSinkTest, CopiesTransientBytes) {
+  std::vector<Filler> fillers{{1}, {2}, {3}};
+
+  ScatterGatherSink sink;
+  ScaleEncoderStream s{sink, 256};
+  s << fillers;
+  s.flush();
+
+  auto expected = scale::encode(fillers).value();
+  ASSERT_EQ(sink.size(), expected.size());
+  ASSERT_EQ(gather(sink.iovecs()), expected);
+}
@@ -0,0 +1,81 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <sstream>
+
+#include "scale/scale.hpp"
+#include "scale/stream_sinks.hpp"
+
+using scale::ByteArray;
+using scale::FileDescriptorSink;
+using scale::OstreamSink;
+using scale::ScaleEncoderStream;
+
+/**
+ * @given collection streamed item by item after its length
+ * @when it is encoded to std::ostream through a small buffer
+ * @then the stream never holds more than the buffer @and the output equals
+ * encoding of the whole collection
+ */
+TEST(StreamSinksTest, StreamsToOstream) {
+  std::vector<std::string> items(100, std::string(50, 'x'));
+
+  std::ostringstream out;
+  OstreamSink sink{out};
+  ScaleEncoderStream s{sink, 128};
+  s.encodeCollectionLength(items.size());
+  for (const auto &item : items) {
+    s << item;
+    ASSERT_LT(s.to_vector().size(), 128);
+  }
+  s.flush();
+
+  auto expected = scale::encode(items).value();
+  auto str = out.str();
+  ASSERT_EQ(ByteArray(str.begin(), str.end()), expected);
+  ASSERT_EQ(s.size(), expected.size());
+}
+
+/**
+ * @given file descriptor of a temporary file
+ * @when data including a range larger than the buffer is encoded to it
+ * @then the file contains encoded data
+ */
+TEST(StreamSinksTest, StreamsToFileDescriptor) {
+  FILE *file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  int fd = fileno(file);
+
+  ByteArray payload(1000, 0x5A);
+  FileDescriptorSink sink{fd};
+  ScaleEncoderStream s{sink, 64};
+  s << uint32_t{7} << payload << std::string("tail");
+  s.flush();
+
+  auto expected =
+      scale::encode(uint32_t{7}, payload, std::string("tail")).value();
+  ByteArray content(expected.size() + 1);
+  ASSERT_EQ(::pread(fd, content.data(), content.size(), 0), expected.size());
+  content.resize(expected.size());
+  ASSERT_EQ(content, expected);
+  std::fclose(file);
+}
+
+/**
+ * @given closed file descriptor
+ * @when data is flushed to it
+ * @then system error is thrown
+ */
+TEST(StreamSinksTest, ReportsWriteError) {
+  FileDescriptorSink sink{-1};
+  ScaleEncoderStream s{sink, 16};
+  s << uint64_t{1};
+  ASSERT_THROW(s.flush(), std::system_error);
+}
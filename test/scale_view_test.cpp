@@ -0,0 +1,109 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/scale.hpp"
+#include "scale/view.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::DecodeError;
+using scale::View;
+
+struct Digest {
+  SCALE_TIE(2);
+  std::vector<ByteArray> logs;
+  uint8_t kind;
+};
+
+struct Header {
+  SCALE_TIE(5);
+  std::array<uint8_t, 32> parent;
+  uint32_t number;
+  Digest digest;
+  std::string author;
+  uint64_t timestamp;
+};
+
+namespace {
+  Header makeHeader() {
+    Header header{};
+    header.parent.fill(7);
+    header.number = 42;
+    header.digest = Digest{{{1, 2, 3}, {4}}, 9};
+    header.author = "alice";
+    header.timestamp = 1'600'000'000;
+    return header;
+  }
+}  // namespace
+
+/**
+ * @given encoded struct described with SCALE_TIE
+ * @when its fields are read through a view
+ * @then fields are equal to the encoded ones @and their bytes are located
+ * within the encoded value
+ */
+TEST(View, ReadsFields) {
+  auto header = makeHeader();
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(header));
+  View<Header> view{encoded};
+
+  EXPECT_OUTCOME_TRUE(number, view.get<1>());
+  ASSERT_EQ(number, header.number);
+  EXPECT_OUTCOME_TRUE(timestamp, view.get<4>());
+  ASSERT_EQ(timestamp, header.timestamp);
+  EXPECT_OUTCOME_TRUE(author, view.get<3>());
+  ASSERT_EQ(author, header.author);
+  EXPECT_OUTCOME_TRUE(parent, view.get<0>());
+  ASSERT_EQ(parent, header.parent);
+
+  EXPECT_OUTCOME_TRUE(author_bytes, view.bytes<3>());
+  ASSERT_EQ(author_bytes.data(), encoded.data() + 32 + 4 + 8);
+  EXPECT_OUTCOME_TRUE(expected_author, scale::encode(header.author));
+  ASSERT_EQ(ByteArray(author_bytes.begin(), author_bytes.end()),
+            expected_author);
+
+  EXPECT_OUTCOME_TRUE(size, view.size());
+  ASSERT_EQ(size, encoded.size());
+}
+
+/**
+ * @given encoded struct with a nested struct
+ * @when the nested struct is read through a nested view
+ * @then its fields are equal to the encoded ones
+ */
+TEST(View, NestedView) {
+  auto header = makeHeader();
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(header));
+  View<Header> view{encoded};
+  EXPECT_OUTCOME_TRUE(digest, view.view<2>());
+  EXPECT_OUTCOME_TRUE(kind, digest.get<1>());
+  ASSERT_EQ(kind, header.digest.kind);
+  EXPECT_OUTCOME_TRUE(logs, digest.get<0>());
+  ASSERT_EQ(logs, header.digest.logs);
+}
+
+/**
+ * @given truncated encoded struct
+ * @when its fields are read through a view
+ * @then fields before the cut are read @and the others are not
+ */
+TEST(View, Truncated) {
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(makeHeader()));
+  encoded.resize(40);
+  View<Header> view{encoded};
+  EXPECT_OUTCOME_TRUE(number, view.get<1>());
+  ASSERT_EQ(number, 42);
+  EXPECT_OUTCOME_FALSE(e, view.get<4>());
+  ASSERT_EQ(e, DecodeError::NOT_ENOUGH_DATA);
+  EXPECT_OUTCOME_FALSE_1(view.get<2>());
+
+  encoded.resize(20);
+  View<Header> short_view{encoded};
+  EXPECT_OUTCOME_FALSE(short_error, short_view.get<1>());
+  ASSERT_EQ(short_error, DecodeError::NOT_ENOUGH_DATA);
+  EXPECT_OUTCOME_FALSE_1(short_view.get<3>());
+}